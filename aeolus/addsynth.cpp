@@ -180,6 +180,16 @@ void N_func::read (QFile* f)
 #endif
 }
 
+//---------------------------------------------------------
+//   digest
+//---------------------------------------------------------
+
+void N_func::digest (QCryptographicHash* h) const
+      {
+      h->addData ((const char*)&_b, sizeof (_b));
+      h->addData ((const char*)_v, N_NOTE * sizeof (float));
+      }
+
 //---------------------------------------------------------
 //   reset
 //---------------------------------------------------------
@@ -230,6 +240,16 @@ void HN_func::read (QFile* f, int k)
             (_h + j)->read(f);
       }
 
+//---------------------------------------------------------
+//   digest
+//---------------------------------------------------------
+
+void HN_func::digest (QCryptographicHash* h) const
+      {
+      for (int j = 0; j < N_HARM; j++)
+            _h [j].digest (h);
+      }
+
 //---------------------------------------------------------
 //   Addsynth
 //---------------------------------------------------------
@@ -267,6 +287,32 @@ void Addsynth::reset()
       _h_atp.reset (0.0f);
       }
 
+//---------------------------------------------------------
+//   digest
+//    hash of the parameters the pipe waves are generated
+//    from
+//---------------------------------------------------------
+
+QByteArray Addsynth::digest() const
+      {
+      QCryptographicHash h(QCryptographicHash::Sha1);
+      int32_t d[4] = { _n0, _n1, _fn, _fd };
+      h.addData ((const char*)d, sizeof (d));
+      _n_vol.digest (&h);
+      _n_off.digest (&h);
+      _n_ran.digest (&h);
+      _n_ins.digest (&h);
+      _n_att.digest (&h);
+      _n_atd.digest (&h);
+      _n_dct.digest (&h);
+      _n_dcd.digest (&h);
+      _h_lev.digest (&h);
+      _h_ran.digest (&h);
+      _h_att.digest (&h);
+      _h_atp.digest (&h);
+      return h.result();
+      }
+
 //---------------------------------------------------------
 //   save
 //---------------------------------------------------------
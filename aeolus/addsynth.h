@@ -53,6 +53,7 @@ class N_func
             }
       void write(FILE*);
       void read(QFile*);
+      void digest(QCryptographicHash*) const;
       };
 
 //---------------------------------------------------------
@@ -76,6 +77,7 @@ class HN_func
       float vi (int h, int n) const { return _h [h].vi (n); }
       void write (FILE *F, int k);
       void read (QFile *F, int k);
+      void digest (QCryptographicHash*) const;
       };
 
 //---------------------------------------------------------
@@ -90,6 +92,7 @@ class Addsynth
       void reset();
       int save (const char *sdir);
       int load (const char *sdir);
+      QByteArray digest() const;
 
       char       _filename [64];
       char       _stopname [32];
@@ -93,8 +93,10 @@ void Aeolus::init(float samplerate)
       char* stopsPath = new char[n+1];
       strcpy(stopsPath, qPrintable(stops));
 
+      // one cache for all sample rates and temperaments, the
+      // file names are the keys of the waves
       QDir dir;
-      QString waves = dataPath + QString("/aeolus/waves%1").arg(int(samplerate));
+      QString waves = dataPath + "/aeolus/waves";
       dir.mkpath(waves);
       n = strlen(qPrintable(waves));
       char* wavesPath = new char[n+1];
@@ -106,7 +106,6 @@ void Model::init()
 
       init_iface();
       init_ranks(MT_LOAD_RANK);
-      init_ranks(MT_SAVE_RANK);
       }
 
 //---------------------------------------------------------
@@ -167,6 +166,7 @@ void Model::init_ranks (int comm)
             for (int i = 0; i < G->_nifelm; i++)
                   proc_rank (g, i, comm);
             }
+      gen_ranks();
       _ready = true;
       }
 
@@ -202,14 +202,43 @@ void Model::proc_rank (int g, int i, int comm)
 
                   M._wave = new Rankwave (M._sdef->_n0, M._sdef->_n1);
                   if (M._wave->load (M._path, M._sdef, M._fsamp, M._fbase, M._scale))
-                        M._wave->gen_waves (M._sdef, M._fsamp, M._fbase, M._scale);
-
-                  _aeolus->_divisp [M._divis]->set_rank (M._rank, M._wave,  M._sdef->_pan, M._sdef->_del);
-                  _divis [M._divis]._ranks [M._rank]._wave = M._wave;
+                        _pending.push_back (M);
+                  else
+                        set_rank (M);
                   }
             }
       }
 
+//---------------------------------------------------------
+//   gen_ranks
+//    Generate the waves of the ranks which are not in the
+//    cache, all ranks at once, and save them to the cache.
+//---------------------------------------------------------
+
+void Model::gen_ranks()
+      {
+      if (_pending.empty())
+            return;
+      QtConcurrent::blockingMap(_pending, [](M_def_rank& M) {
+            M._wave->gen_waves (M._sdef, M._fsamp, M._fbase, M._scale);
+            M._wave->save (M._path, M._sdef, M._fsamp, M._fbase, M._scale);
+            });
+      for (const M_def_rank& M : _pending)
+            set_rank (M);
+      _pending.clear();
+      }
+
+//---------------------------------------------------------
+//   set_rank
+//    hand the waves of a rank to its division
+//---------------------------------------------------------
+
+void Model::set_rank (const M_def_rank& M)
+      {
+      _aeolus->_divisp [M._divis]->set_rank (M._rank, M._wave,  M._sdef->_pan, M._sdef->_del);
+      _divis [M._divis]._ranks [M._rank]._wave = M._wave;
+      }
+
 //---------------------------------------------------------
 //   set_ifelm
 //    Set, reset or toggle a stop.
@@ -338,6 +367,7 @@ void Model::recalc (int g, int i)
       _count++;
       _ready = false;
       proc_rank (g, i, MT_CALC_RANK);
+      gen_ranks();
       }
 
 #if 0
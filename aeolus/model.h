@@ -21,6 +21,8 @@
 #define __MODEL_H
 
 
+#include <vector>
+
 #include "messages.h"
 #include "addsynth.h"
 #include "rankwave.h"
@@ -165,11 +167,14 @@ class Model
       int             _sc_group; // stop control group number
       Chconf          _chconf [8];
       Preset*         _preset [NBANK][NPRES];
+      std::vector<M_def_rank> _pending;   // ranks not found in the wave cache
 
       void init_audio();
       void init_iface();
       void init_ranks(int comm);
       void proc_rank(int g, int i, int comm);
+      void gen_ranks();
+      void set_rank(const M_def_rank&);
       void set_mconf(int i, uint16_t *d);
       void get_state(uint32_t *bits);
       void set_state(int bank, int pres);
@@ -16,26 +16,23 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
-#include "rankwave.h"
+#include <vector>
 
-#define DEBUG
+#include "rankwave.h"
 
 extern float exp2ap (float);
 
+//---------------------------------------------------------
+//   wave cache file
+//    16 byte tag, 64 byte header with the note range,
+//    sample rate, tuning and temperament, then for every
+//    pipe a 32 byte record followed by its wave
+//---------------------------------------------------------
 
-Rngen   Pipewave::_rgen;
-float  *Pipewave::_arg = 0;
-float  *Pipewave::_att = 0;
+static const char CACHE_VERSION = 2;
+static const int CACHE_HEADER   = 16 + 64;
 
-void Pipewave::initstatic(float fsamp)
-      {
-      if (_arg)
-            return;
-      int k = (int)(fsamp);
-      _arg  = new float [k];
-      k     = (int)(0.5f * fsamp);
-      _att  = new float [k];
-      }
+Rngen   Pipewave::_rgen;
 
 //---------------------------------------------------------
 //   play
@@ -183,7 +180,7 @@ void Pipewave::play()
 }
 
 
-void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
+void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe, Rngen& rgen, float *arg, float *att)
 {
     int    h, i, k, nc;
     float  f0, f1, f, m, t, v, v0;
@@ -197,7 +194,7 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     _l0 = (int)(fsamp * m + 0.5);
     _l0 = (_l0 + PERIOD - 1) & ~(PERIOD - 1);
 
-    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * _rgen.urand () - 1)) / fsamp;
+    f1 = (fpipe + D->_n_off.vi (n) + D->_n_ran.vi (n) * (2 * rgen.urand () - 1)) / fsamp;
     f0 = f1 * exp2ap (D->_n_atd.vi (n) / 1200.0f);
 
     for (h = N_HARM - 1; h >= 0; h--)
@@ -219,8 +216,9 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
 
     k = _l0 + _l1 + _k_s * (PERIOD + 4);
 
-    delete[] _p0;
+    if (_own) delete[] _p0;
     _p0 = new float [k];
+    _own = true;
     _p1 = _p0 + _l0;
     _p2 = _p1 + _l1;
     memset (_p0, 0, k * sizeof (float));
@@ -234,14 +232,14 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
     k = (int)(fsamp * D->_n_att.vi (n) + 0.5);
     for (i = 0; i <= _l0; i++)
     {
-        _arg [i] = t - floorf (t + 0.5);
+        arg [i] = t - floorf (t + 0.5);
 	t += (i < k) ? (((k - i) * f0 + i * f1) / k) : f1;
     }
 
     for (i = 1; i < _l1; i++)
     {
-	t = _arg [_l0]+ (float) i * nc / _l1;
-        _arg [i + _l0] = t - floorf (t + 0.5);
+	t = arg [_l0]+ (float) i * nc / _l1;
+        arg [i + _l0] = t - floorf (t + 0.5);
     }
 
     v0 = exp2ap (0.1661 * D->_n_vol.vi (n));
@@ -251,16 +249,16 @@ void Pipewave::genwave (Addsynth *D, int n, float fsamp, float fpipe)
         v = D->_h_lev.vi (h, n);
         if (v < -80.0) continue;
 
-        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * _rgen.urand () - 1)));
+        v = v0 * exp2ap (0.1661 * (v + D->_h_ran.vi (h, n) * (2 * rgen.urand () - 1)));
         k = (int)(fsamp * D->_h_att.vi (h, n) + 0.5);
-        attgain (k, D->_h_atp.vi (h, n));
+        attgain (k, D->_h_atp.vi (h, n), att);
 
         for (i = 0; i < _l0 + _l1; i++)
         {
-	    t = _arg [i] * (h + 1);
+	    t = arg [i] * (h + 1);
             t -= floorf (t);
             m = v * sinf (2 * M_PI * t);
-            if (i < k) m *= _att [i];
+            if (i < k) m *= att [i];
             _p0 [i] += m;
         }
     }
@@ -311,7 +309,7 @@ void Pipewave::looplen (float f, float fsamp, int lmax, int *aa, int *bb)
 }
 
 
-void Pipewave::attgain (int n, float p)
+void Pipewave::attgain (int n, float p, float *att)
 {
     int    i, j, k;
     float  d, m, w, x, y, z;
@@ -331,66 +329,82 @@ void Pipewave::attgain (int n, float p)
         while (j < k)
 	{
             m = (double) j / n;
-            _att [j++] = (1.0 - m) * z + m;
+            att [j++] = (1.0 - m) * z + m;
             z += d;
 	}
     }
 }
 
 
-void Pipewave::save (FILE *F)
-{
-    int  k;
-    union
-    {
-        int16_t i16 [16];
-        int32_t i32 [8];
-	float   flt [8];
-    } d;
-
-    d.i32 [0] = _l0;
-    d.i32 [1] = _l1;
-    d.i16 [4] = _k_s;
-    d.i16 [5] = _k_r;
-    d.flt [3] = _m_r;
-    d.i32 [4] = 0;
-    d.i32 [5] = 0;
-    d.i32 [6] = 0;
-    d.i32 [7] = 0;
-    fwrite (&d, 1, 32, F);
-    k = _l0 +_l1 + _k_s * (PERIOD + 4);
-    fwrite (_p0, k, sizeof (float), F);
-}
-
+//---------------------------------------------------------
+//   save
+//---------------------------------------------------------
 
-void Pipewave::load (FILE *F)
-{
-    int  k;
-    union
-    {
-        int16_t i16 [16];
-        int32_t i32 [8];
-	float   flt [8];
-    } d;
-
-    fread (&d, 1, 32, F);
-    _l0  = d.i32 [0];
-    _l1  = d.i32 [1];
-    _k_s = d.i16 [4];
-    _k_r = d.i16 [5];
-    _m_r = d.flt [3];
-    k = _l0 +_l1 + _k_s * (PERIOD + 4);
-    delete[] _p0;
-    _p0 = new float [k];
-    _p1 = _p0 + _l0;
-    _p2 = _p1 + _l1;
-    fread (_p0, k, sizeof (float), F);
-}
+void Pipewave::save (QIODevice* F)
+      {
+      union {
+            int16_t i16 [16];
+            int32_t i32 [8];
+            float   flt [8];
+            } d;
+
+      memset (&d, 0, sizeof (d));
+      d.i32 [0] = _l0;
+      d.i32 [1] = _l1;
+      d.i16 [4] = _k_s;
+      d.i16 [5] = _k_r;
+      d.flt [3] = _m_r;
+      d.flt [4] = _d_r;
+      d.flt [5] = _d_p;
+      F->write ((const char*)&d, 32);
+      int k = _l0 +_l1 + _k_s * (PERIOD + 4);
+      F->write ((const char*)_p0, k * sizeof (float));
+      }
 
+//---------------------------------------------------------
+//   map
+//    Use the wave at p in a mapped cache file. Return the
+//    position of the next record or 0 if the file is too
+//    short.
+//---------------------------------------------------------
 
+const uchar* Pipewave::map (const uchar* p, const uchar* end)
+      {
+      union {
+            int16_t i16 [16];
+            int32_t i32 [8];
+            float   flt [8];
+            } d;
+
+      if (end - p < 32)
+            return 0;
+      memcpy (&d, p, 32);
+      p += 32;
+      if (d.i32 [0] < 0 || d.i32 [1] <= 0 || d.i16 [4] < 1 || d.i16 [4] > 3)
+            return 0;
+      long long k = (long long)d.i32 [0] + d.i32 [1] + d.i16 [4] * (PERIOD + 4);
+      if ((end - p) / (long long)sizeof (float) < k)
+            return 0;
+
+      _l0  = d.i32 [0];
+      _l1  = d.i32 [1];
+      _k_s = d.i16 [4];
+      _k_r = d.i16 [5];
+      _m_r = d.flt [3];
+      _d_r = d.flt [4];
+      _d_p = d.flt [5];
+      if (_own)
+            delete[] _p0;
+      _own = false;
+      // the mapping is read only, play() never writes to the wave
+      _p0 = const_cast<float*>(reinterpret_cast<const float*>(p));
+      _p1 = _p0 + _l0;
+      _p2 = _p1 + _l1;
+      return p + k * sizeof (float);
+      }
 
 
-Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (false)
+Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (false), _file (0)
 {
     _pipes = new Pipewave [n1 - n0 + 1];
 }
@@ -399,20 +413,35 @@ Rankwave::Rankwave (int n0, int n1) : _n0 (n0), _n1 (n1), _list (0), _modif (fal
 Rankwave::~Rankwave (void)
 {
     delete[] _pipes;
+    delete _file;
 }
 
+//---------------------------------------------------------
+//   gen_waves
+//    Does not touch any shared state and can run for
+//    several ranks at once. The random variation of the
+//    pipes is seeded from the cache key, so a rank is
+//    generated the same way every time.
+//---------------------------------------------------------
 
 void Rankwave::gen_waves (Addsynth *D, float fsamp, float fbase, float *scale)
-{
-    Pipewave::initstatic (fsamp);
-
-    fbase *=  D->_fn / (D->_fd * scale [9]);
-    for (int i = _n0; i <= _n1; i++)
-    {
-	_pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5));
-    }
-    _modif = true;
-}
+      {
+      std::vector<float> arg((int)(fsamp));
+      std::vector<float> att((int)(0.5f * fsamp));
+
+      QByteArray k = key (D, fsamp, fbase, scale);
+      uint32_t seed;
+      memcpy (&seed, k.constData(), sizeof (seed));
+      Rngen rgen;
+      rgen.init (seed);
+
+      fbase *=  D->_fn / (D->_fd * scale [9]);
+      for (int i = _n0; i <= _n1; i++) {
+            _pipes [i - _n0].genwave (D, i - _n0, fsamp, ldexpf (fbase * scale [i % 12], i / 12 - 5),
+               rgen, arg.data(), att.data());
+            }
+      _modif = true;
+      }
 
 
 void Rankwave::set_param (float *out, int del, int pan)
@@ -450,143 +479,108 @@ void Rankwave::play (int shift)
 }
 
 
-int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
-{
-    FILE      *F;
-    Pipewave  *P;
-    int        i;
-    char       name [1024];
-    char       data [64];
-    char      *p;
-
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
-
-    F = fopen (name, "wb");
-    if (F == NULL)
-    {
-	fprintf (stderr, "Can't open waveform file '%s' for writing\n", name);
-        return 1;
-    }
-
-    memset (data, 0, 16);
-    strcpy (data, "ae1");
-    data [4] = 1;
-    fwrite (data, 1, 16, F);
-
-    memset (data, 0, 64);
-    data [0] = 0;
-    data [1] = 0;
-    data [2] = 0;
-    data [3] = 0;
-    data [4] = _n0;
-    data [5] = _n1;
-    data [6] = 0;
-    data [7] = 0;
-    *((float *)(data +  8)) = fsamp;
-    *((float *)(data + 12)) = fbase;
-    memcpy (data + 16, scale, 12 * sizeof (float));
-    fwrite (data, 1, 64, F);
-
-    for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->save (F);
-
-    fclose (F);
-
-    _modif = false;
-    return 0;
-}
-
-
-int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
-{
-    FILE      *F;
-    Pipewave  *P;
-    int        i;
-    char       name [1024];
-    char       data [64];
-    char      *p;
-    float      f;
-
-    sprintf (name, "%s/%s", path, D->_filename);
-    if ((p = strrchr (name, '.'))) strcpy (p, ".ae1");
-    else strcat (name, ".ae1");
-
-    F = fopen (name, "rb");
-    if (F == NULL)
-    {
-#ifdef DEBUG
-	fprintf (stderr, "Can't open waveform file '%s' for reading\n", name);
-#endif
-        return 1;
-    }
-
-    fread (data, 1, 16, F);
-    if (strcmp (data, "ae1"))
-    {
-#ifdef DEBUG
-	fprintf (stderr, "File '%s' is not an Aeolus waveform file\n", name);
-#endif
-        fclose (F);
-        return 1;
-    }
+//---------------------------------------------------------
+//   key
+//    hash of everything the waves of the rank depend on
+//---------------------------------------------------------
 
-    if (data [4] != 1)
-    {
-#ifdef DEBUG
-	fprintf (stderr, "File '%s' has an incompatible version tag (%d)\n", name, data [4]);
-#endif
-        fclose (F);
-        return 1;
-    }
+QByteArray Rankwave::key (Addsynth *D, float fsamp, float fbase, float *scale) const
+      {
+      QCryptographicHash h(QCryptographicHash::Sha1);
+      int32_t n[2] = { _n0, _n1 };
+      h.addData (&CACHE_VERSION, 1);
+      h.addData (D->digest());
+      h.addData ((const char*)n, sizeof (n));
+      h.addData ((const char*)&fsamp, sizeof (float));
+      h.addData ((const char*)&fbase, sizeof (float));
+      h.addData ((const char*)scale, 12 * sizeof (float));
+      return h.result();
+      }
 
-    fread (data, 1, 64, F);
-    if (_n0 != data [4] || _n1 != data [5])
-    {
-#ifdef DEBUG
-	fprintf (stderr, "File '%s' has an incompatible note range (%d %d), (%d %d)\n", name, _n0, _n1, data [4], data [5]);
-#endif
-        fclose (F);
-        return 1;
-    }
+//---------------------------------------------------------
+//   cacheName
+//---------------------------------------------------------
 
-    f = *((float *)(data + 8));
-    if (fabsf (f - fsamp) > 0.1f)
-    {
-#ifdef DEBUG
-	fprintf (stderr, "File '%s' has a different sample frequency (%3.1lf)\n", name, f);
-#endif
-        fclose (F);
-        return 1;
-    }
+QString Rankwave::cacheName (const char *path, Addsynth *D, float fsamp, float fbase, float *scale) const
+      {
+      return QString("%1/%2.ae2").arg(path).arg(QString(key (D, fsamp, fbase, scale).toHex()));
+      }
 
-    f = *((float *)(data + 12));
-    if (fabsf (f - fbase) > 0.1f)
-    {
-#ifdef DEBUG
-	fprintf (stderr, "File '%s' has a different tuning (%3.1lf)\n", name, f);
-#endif
-        fclose (F);
-        return 1;
-    }
+//---------------------------------------------------------
+//   save
+//    Write the waves to the cache. The file only appears
+//    under its name when it is complete.
+//---------------------------------------------------------
 
-    for (i = 0; i < 12; i++)
-    {
-        f = *((float *)(data + 16 + 4 * i));
-        if (fabsf (f /  scale [i] - 1.0f) > 6e-5f)
-        {
-#ifdef DEBUG
-	    fprintf (stderr, "File '%s' has a different temperament\n", name);
-#endif
-            fclose (F);
+int Rankwave::save (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
+      {
+      QSaveFile f(cacheName (path, D, fsamp, fbase, scale));
+      if (!f.open (QIODevice::WriteOnly)) {
+            qDebug("Aeolus: cannot write wave cache <%s>", qPrintable(f.fileName()));
             return 1;
-        }
-    }
+            }
 
-    for (i = _n0, P = _pipes; i <= _n1; i++, P++) P->load (F);
+      char data [CACHE_HEADER];
+      int32_t n[2] = { _n0, _n1 };
+      memset (data, 0, CACHE_HEADER);
+      strcpy (data, "ae2");
+      data [4] = CACHE_VERSION;
+      memcpy (data + 16, n, sizeof (n));
+      memcpy (data + 24, &fsamp, sizeof (float));
+      memcpy (data + 28, &fbase, sizeof (float));
+      memcpy (data + 32, scale, 12 * sizeof (float));
+      f.write (data, CACHE_HEADER);
+
+      Pipewave* P = _pipes;
+      for (int i = _n0; i <= _n1; i++, P++)
+            P->save (&f);
+
+      if (!f.commit ()) {
+            qDebug("Aeolus: cannot write wave cache <%s>", qPrintable(f.fileName()));
+            return 1;
+            }
+      _modif = false;
+      return 0;
+      }
 
-    fclose (F);
+//---------------------------------------------------------
+//   load
+//    Map the waves from the cache. The file name is the
+//    key of the waves, so only the layout is checked.
+//    return 1 if the waves have to be generated
+//---------------------------------------------------------
 
-    _modif = false;
-    return 0;
-}
+int Rankwave::load (const char *path, Addsynth *D, float fsamp, float fbase, float *scale)
+      {
+      QFile* f = new QFile(cacheName (path, D, fsamp, fbase, scale));
+      const uchar* p = 0;
+      if (f->open (QIODevice::ReadOnly) && f->size() >= CACHE_HEADER)
+            p = f->map (0, f->size());
+      if (!p) {
+            delete f;
+            return 1;
+            }
+      const uchar* end = p + f->size();
+      int32_t n[2];
+      memcpy (n, p + 16, sizeof (n));
+      bool ok = !memcmp (p, "ae2", 4) && p [4] == CACHE_VERSION && n [0] == _n0 && n [1] == _n1;
+
+      p += CACHE_HEADER;
+      Pipewave* P = _pipes;
+      for (int i = _n0; ok && i <= _n1; i++, P++)
+            ok = (p = P->map (p, end)) != 0;
+
+      if (!ok) {
+            qDebug("Aeolus: bad wave cache <%s>", qPrintable(f->fileName()));
+            for (P = _pipes; P <= _pipes + (_n1 - _n0); P++) {
+                  if (!P->_own)
+                        P->_p0 = 0;
+                  }
+            delete f;
+            return 1;
+            }
+      delete _file;
+      _file  = f;
+      _modif = false;
+      return 0;
+      }
@@ -33,22 +33,22 @@ class Pipewave
 private:
 
     Pipewave () :
-        _p0 (0), _p1 (0), _p2 (0), _l1 (0), _k_s (0),  _k_r (0), _m_r (0),
+        _p0 (0), _p1 (0), _p2 (0), _l1 (0), _k_s (0),  _k_r (0), _m_r (0), _own (false),
         _link (0), _sbit (0), _sdel (0),
         _p_p (0), _y_p (0), _z_p (0), _p_r (0), _y_r (0), _g_r (0), _i_r (0)
     {}
 
-    ~Pipewave (void) { delete[] _p0; }
+    ~Pipewave (void) { if (_own) delete[] _p0; }
 
     friend class Rankwave;
 
-    void genwave (Addsynth *D, int n, float fsamp, float fpipe);
-    void save (FILE *F);
-    void load (FILE *F);
+    void genwave (Addsynth *D, int n, float fsamp, float fpipe, Rngen& rgen, float *arg, float *att);
+    void save (QIODevice *F);
+    const uchar* map (const uchar *p, const uchar *end);
     void play (void);
 
     static void looplen (float f, float fsamp, int lmax, int *aa, int *bb);
-    static void attgain (int n, float p);
+    static void attgain (int n, float p, float *att);
 
     float     *_p0;    // attack start
     float     *_p1;    // loop start
@@ -60,6 +60,7 @@ private:
     float      _m_r;   // release multiplier
     float      _d_r;   // release detune
     float      _d_p;   // instability
+    bool       _own;   // _p0 was generated, not mapped from the cache
 
     Pipewave  *_link;  // link to next in active chain
     uint32_t   _sbit;  // on state bit
@@ -74,11 +75,7 @@ private:
     int16_t    _i_r;   // release count
 
 
-    static void initstatic (float fsamp);
-
-    static   Rngen   _rgen;
-    static   float  *_arg;
-    static   float  *_att;
+    static   Rngen   _rgen;     // instability noise, used by play() only
 };
 
 //---------------------------------------------------------
@@ -96,6 +93,10 @@ class Rankwave
       Pipewave   *_list;
       Pipewave   *_pipes;
       bool        _modif;
+      QFile      *_file;   // wave cache the pipes are mapped from
+
+      QByteArray key (Addsynth *D, float fsamp, float fbase, float *scale) const;
+      QString cacheName (const char *path, Addsynth *D, float fsamp, float fbase, float *scale) const;
 
 public:
 
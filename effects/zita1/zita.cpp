@@ -21,6 +21,94 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   ZITA_VECTOR
+//    The feedback delay network is processed in blocks of
+//    samples; the per block loops below run over samples or,
+//    for the recursive filters, over the eight lines and are
+//    vectorized by the compiler. On
+//    x86-64 Linux an AVX2 version of each loop is built next
+//    to the baseline one and selected at load time.
+//---------------------------------------------------------
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define ZITA_VECTOR __attribute__((target_clones("avx2", "default")))
+#else
+#define ZITA_VECTOR
+#endif
+
+ZITA_VECTOR static void addBlock(float* x, const float* t, int n)
+      {
+      for (int i = 0; i < n; ++i)
+            x[i] += t[i];
+      }
+
+ZITA_VECTOR static void subBlock(float* x, const float* t, int n)
+      {
+      for (int i = 0; i < n; ++i)
+            x[i] -= t[i];
+      }
+
+ZITA_VECTOR static void mixBlock(float (*x)[ZitaReverb::MAXBLOCK], int n)
+      {
+      for (int i = 0; i < n; ++i) {
+            float a0 = x [0][i] + x [1][i], a1 = x [0][i] - x [1][i];
+            float a2 = x [2][i] + x [3][i], a3 = x [2][i] - x [3][i];
+            float a4 = x [4][i] + x [5][i], a5 = x [4][i] - x [5][i];
+            float a6 = x [6][i] + x [7][i], a7 = x [6][i] - x [7][i];
+            float b0 = a0 + a2, b2 = a0 - a2;
+            float b1 = a1 + a3, b3 = a1 - a3;
+            float b4 = a4 + a6, b6 = a4 - a6;
+            float b5 = a5 + a7, b7 = a5 - a7;
+            x [0][i] = b0 + b4;
+            x [4][i] = b0 - b4;
+            x [1][i] = b1 + b5;
+            x [5][i] = b1 - b5;
+            x [2][i] = b2 + b6;
+            x [6][i] = b2 - b6;
+            x [3][i] = b3 + b7;
+            x [7][i] = b3 - b7;
+            }
+      }
+
+ZITA_VECTOR static void filterBlock(float* slo, float* shi, const float* wlo, const float* glo,
+   const float* whi, const float* gmf, float g, float (*x)[ZitaReverb::MAXBLOCK], int n)
+      {
+      // local copies of the filter state can be kept in registers
+      float sl [8], sh [8], wl [8], gl [8], wh [8], gm [8];
+      for (int j = 0; j < 8; ++j) {
+            sl [j] = slo [j];
+            sh [j] = shi [j];
+            wl [j] = wlo [j];
+            gl [j] = glo [j];
+            wh [j] = whi [j];
+            gm [j] = gmf [j];
+            }
+      for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                  float y = g * x [j][i];
+                  sl [j] += wl [j] * (y - sl [j]) + 1e-10f;
+                  y += gl [j] * sl [j];
+                  sh [j] += wh [j] * (y - sh [j]);
+                  x [j][i] = gm [j] * sh [j];
+                  }
+            }
+      for (int j = 0; j < 8; ++j) {
+            slo [j] = sl [j];
+            shi [j] = sh [j];
+            }
+      }
+
+ZITA_VECTOR static void diffuseBlock(float* line, float c, float* x, int n)
+      {
+      for (int i = 0; i < n; ++i) {
+            float z = line[i];
+            float y = x[i] - c * z;
+            line[i] = y;
+            x[i] = z + c * y;
+            }
+      }
+
 enum {
       R_DELAY, R_XOVER, R_RTLOW, R_RTMID, R_FDAMP,
       R_EQ1FR, R_EQ1GN,
@@ -233,6 +321,21 @@ void Diff1::fini()
       _line = 0;
       }
 
+//---------------------------------------------------------
+//   process
+//    process n <= _size samples in place
+//---------------------------------------------------------
+
+void Diff1::process(float* x, int n)
+      {
+      int n1 = qMin(n, _size - _i);
+      diffuseBlock(_line + _i, _c, x, n1);
+      diffuseBlock(_line, _c, x + n1, n - n1);
+      _i += n;
+      if (_i >= _size)
+            _i -= _size;
+      }
+
 Delay::Delay()
    : _size (0), _line (0)
       {
@@ -258,6 +361,33 @@ void Delay::fini ()
       _line = 0;
       }
 
+//---------------------------------------------------------
+//   read
+//    read n <= _size samples from the current position
+//---------------------------------------------------------
+
+void Delay::read(float* x, int n) const
+      {
+      int n1 = qMin(n, _size - _i);
+      memcpy(x, _line + _i, n1 * sizeof(float));
+      memcpy(x + n1, _line, (n - n1) * sizeof(float));
+      }
+
+//---------------------------------------------------------
+//   write
+//    replace the n samples read last and advance
+//---------------------------------------------------------
+
+void Delay::write(const float* x, int n)
+      {
+      int n1 = qMin(n, _size - _i);
+      memcpy(_line + _i, x, n1 * sizeof(float));
+      memcpy(_line, x + n1, (n - n1) * sizeof(float));
+      _i += n;
+      if (_i >= _size)
+            _i -= _size;
+      }
+
 Vdelay::Vdelay ()
    : _size (0), _line (0)
       {
@@ -364,6 +494,12 @@ void ZitaReverb::init(float fsamp)
 
       _fragm = 1024;
       _nsamp = 0;
+
+      // a sample written to a line is not read again within a block
+      _block = MAXBLOCK;
+      for (int i = 0; i < 8; i++)
+            _block = qMin(_block, qMin(_diff1 [i]._size, _delay [i]._size));
+      _block = qMax(_block, 1);
       }
 
 
@@ -423,64 +559,69 @@ void ZitaReverb::prepare (int nfram)
 
 void ZitaReverb::process (int nfram, float* inp, float* out)
       {
-      float t, g, x0, x1, x2, x3, x4, x5, x6, x7;
-      g = sqrtf (0.125f);
-
+      const float g = sqrtf (0.125f);
+      float t0 [MAXBLOCK];
+      float t1 [MAXBLOCK];
+      float x [8][MAXBLOCK];
+      float slo [8], shi [8], wlo [8], glo [8], whi [8], gmf [8];
 
       while (nfram) {
             if (!_nsamp) {
                   prepare(_fragm);
                   _nsamp = _fragm;
                   }
+            for (int j = 0; j < 8; ++j) {
+                  slo [j] = _filt1 [j]._slo;
+                  shi [j] = _filt1 [j]._shi;
+                  wlo [j] = _filt1 [j]._wlo;
+                  glo [j] = _filt1 [j]._glo;
+                  whi [j] = _filt1 [j]._whi;
+                  gmf [j] = _filt1 [j]._gmf;
+                  }
 
             int k = _nsamp < nfram ? _nsamp : nfram;
 
-            float* p0 = inp;
-            float* p1 = inp + 1;
-            float* q0 = out;
-            float* q1 = out + 1;
-
-            for (int i = 0; i < k * 2; i += 2) {
-                  _vdelay0.write (p0 [i]);
-                  _vdelay1.write (p1 [i]);
-
-                  t = 0.3f * _vdelay0.read ();
-                  x0 = _diff1 [0].process (_delay [0].read () + t);
-                  x1 = _diff1 [1].process (_delay [1].read () + t);
-                  x2 = _diff1 [2].process (_delay [2].read () - t);
-                  x3 = _diff1 [3].process (_delay [3].read () - t);
-                  t = 0.3f * _vdelay1.read ();
-                  x4 = _diff1 [4].process (_delay [4].read () + t);
-                  x5 = _diff1 [5].process (_delay [5].read () + t);
-                  x6 = _diff1 [6].process (_delay [6].read () - t);
-                  x7 = _diff1 [7].process (_delay [7].read () - t);
-
-                  t = x0 - x1; x0 += x1;  x1 = t;
-                  t = x2 - x3; x2 += x3;  x3 = t;
-                  t = x4 - x5; x4 += x5;  x5 = t;
-                  t = x6 - x7; x6 += x7;  x7 = t;
-                  t = x0 - x2; x0 += x2;  x2 = t;
-                  t = x1 - x3; x1 += x3;  x3 = t;
-                  t = x4 - x6; x4 += x6;  x6 = t;
-                  t = x5 - x7; x5 += x7;  x7 = t;
-                  t = x0 - x4; x0 += x4;  x4 = t;
-                  t = x1 - x5; x1 += x5;  x5 = t;
-                  t = x2 - x6; x2 += x6;  x6 = t;
-                  t = x3 - x7; x3 += x7;  x7 = t;
-
-                  _g1 += _d1;
-
-                  q0 [i] = _g1 * (x1 + x2);
-                  q1 [i] = _g1 * (x1 - x2);
-
-                  _delay [0].write (_filt1 [0].process (g * x0));
-                  _delay [1].write (_filt1 [1].process (g * x1));
-                  _delay [2].write (_filt1 [2].process (g * x2));
-                  _delay [3].write (_filt1 [3].process (g * x3));
-                  _delay [4].write (_filt1 [4].process (g * x4));
-                  _delay [5].write (_filt1 [5].process (g * x5));
-                  _delay [6].write (_filt1 [6].process (g * x6));
-                  _delay [7].write (_filt1 [7].process (g * x7));
+            for (int done = 0; done < k;) {
+                  const int n = qMin(k - done, _block);
+                  const float* p = inp + 2 * done;
+                  float* q = out + 2 * done;
+
+                  for (int i = 0; i < n; ++i) {
+                        _vdelay0.write (p [2 * i]);
+                        _vdelay1.write (p [2 * i + 1]);
+                        t0 [i] = 0.3f * _vdelay0.read ();
+                        t1 [i] = 0.3f * _vdelay1.read ();
+                        }
+
+                  // lines 0, 1, 4, 5 add the input, lines 2, 3, 6, 7 subtract it
+                  for (int j = 0; j < 8; ++j) {
+                        const float* t = (j & 4) ? t1 : t0;
+                        _delay [j].read (x [j], n);
+                        if (j & 2)
+                              subBlock (x [j], t, n);
+                        else
+                              addBlock (x [j], t, n);
+                        _diff1 [j].process (x [j], n);
+                        }
+
+                  mixBlock (x, n);
+
+                  for (int i = 0; i < n; ++i) {
+                        _g1 += _d1;
+                        q [2 * i]     = _g1 * (x [1][i] + x [2][i]);
+                        q [2 * i + 1] = _g1 * (x [1][i] - x [2][i]);
+                        }
+
+                  // the damping filters are recursive in time, run the
+                  // eight of them side by side
+                  filterBlock (slo, shi, wlo, glo, whi, gmf, g, x, n);
+                  for (int j = 0; j < 8; ++j)
+                        _delay [j].write (x [j], n);
+                  done += n;
+                  }
+            for (int j = 0; j < 8; ++j) {
+                  _filt1 [j]._slo = slo [j];
+                  _filt1 [j]._shi = shi [j];
                   }
             _pareq1.process (k, out);
             _pareq2.process (k, out);
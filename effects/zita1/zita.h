@@ -96,6 +96,7 @@ class Diff1
       ~Diff1();
       void  init(int size, float c);
       void  fini();
+      void  process(float* x, int n);
 
       float process(float x) {
             float z = _line [_i];
@@ -155,6 +156,8 @@ class Delay
             if (_i == _size)
                   _i = 0;
             }
+      void read(float* x, int n) const;
+      void write(const float* x, int n);
       int     _i;
       int     _size;
       float  *_line;
@@ -201,6 +204,10 @@ class ZitaReverb : public Effect
       {
       Q_OBJECT
 
+   public:
+      enum { MAXBLOCK = 256 };      // longest block of samples processed at once
+
+   private:
       float   _fsamp;
 
       Vdelay  _vdelay0;
@@ -235,6 +242,7 @@ class ZitaReverb : public Effect
 
       int _fragm;
       int _nsamp;
+      int _block;       // samples processed at once, not longer than any delay line
 
       void prepare(int n);
 
@@ -110,6 +110,9 @@ Fluid::~Fluid()
       _state = FLUID_SYNTH_STOPPED;
       _globalTerminate = true;
       while (!mutex.tryLock()) {}
+#ifdef SOUNDFONT3
+      delete _decoder;
+#endif
       qDeleteAll(activeVoices);
       qDeleteAll(freeVoices);
       qDeleteAll(sfonts);
@@ -225,6 +228,38 @@ void Fluid::allNotesOff(int chan)
             }
       }
 
+//---------------------------------------------------------
+//   setOffline
+//    offline compressed samples are decoded when a note
+//    needs them, so the output does not depend on timing
+//---------------------------------------------------------
+
+void Fluid::setOffline(bool val)
+      {
+      _offline = val;
+#ifdef SOUNDFONT3
+      if (_decoder) {
+            if (_offline)
+                  _decoder->stopDecoding();
+            else
+                  _decoder->startDecoding();
+            }
+#endif
+      }
+
+//---------------------------------------------------------
+//   decodeInBackground
+//---------------------------------------------------------
+
+bool Fluid::decodeInBackground() const
+      {
+#ifdef SOUNDFONT3
+      return _decoder && !_offline;
+#else
+      return false;
+#endif
+      }
+
 //---------------------------------------------------------
 //   allSoundsOff
 //    immediately stop all notes on this channel.
@@ -730,6 +765,19 @@ int Fluid::sfload(const QString& filename)
 
       sf->setId(++sfont_id);
 
+#ifdef SOUNDFONT3
+      for (Sample* s : sf->samples()) {
+            if (s->compressed()) {
+                  if (!_decoder)
+                        _decoder = new SampleDecoder;
+                  _decoder->addFont(sf);
+                  if (!_offline)
+                        _decoder->startDecoding();
+                  break;
+                  }
+            }
+#endif
+
       /* insert the sfont as the first one on the list */
       sfonts.prepend(sf);
 
@@ -754,6 +802,10 @@ bool Fluid::sfunload(int id)
 
       sfonts.removeAll(sf);   // remove the SoundFont from the list
       updatePatchList();
+#ifdef SOUNDFONT3
+      if (_decoder)
+            _decoder->removeFont(sf);
+#endif
 
       delete sf;
       return true;
@@ -33,6 +33,7 @@ class Voice;
 class SFont;
 class Preset;
 class Sample;
+class SampleDecoder;
 class Channel;
 struct Mod;
 class Fluid;
@@ -317,6 +318,9 @@ class Fluid : public Synthesizer {
       //the variable is used to stop loading samples from the sf files
       bool _globalTerminate = false;
 
+      bool _offline = false;
+      SampleDecoder* _decoder = nullptr;  // for compressed samples
+
    protected:
       int _state;                         // the synthesizer state
 
@@ -348,6 +352,8 @@ class Fluid : public Synthesizer {
 
       virtual void allSoundsOff(int);
       virtual void allNotesOff(int);
+      virtual void setOffline(bool) override;
+      bool decodeInBackground() const;
 
       int loadProgress()            { return _loadProgress; }
       void setLoadProgress(int val) { _loadProgress = val; }
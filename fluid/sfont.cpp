@@ -50,6 +50,7 @@ SFVersion::SFVersion()
 SFont::SFont(Fluid* f)
       {
       synth       = f;
+      _map        = 0;
       samplepos   = 0;
       samplesize  = 0;
       _bankOffset = 0;
@@ -208,12 +209,22 @@ bool Preset::noteon(Fluid* synth, unsigned id, int chan, int key, int vel, doubl
                            instrument */
                         if (inst_zone->inside_range(key, vel) && (sample != 0)) {
 
+                              /* the voice holds the sample until it is off; a
+                                 compressed sample may not be decoded yet */
+                              if (!sample->acquire()) {
+                                    sample->load(true);
+                                    if (!sample->acquire())
+                                          continue;
+                                    }
+
                               /* this is a good zone. allocate a new synthesis process and
                                  initialize it */
 
                               Voice* voice = synth->alloc_voice(id, sample, chan, key, vel, nt);
-                              if (voice == 0)
+                              if (voice == 0) {
+                                    sample->release();
                                     return false;
+                                    }
 
                               /* Instrumentrument level, generators */
 
@@ -595,10 +606,19 @@ bool Zone::importZone()
 //   Sample
 //---------------------------------------------------------
 
+std::atomic<unsigned> Sample::useCount { 0 };
+
 Sample::Sample(SFont* s)
       {
       sf          = s;
       _valid      = false;
+      _ownData    = false;
+      _state      = UNLOADED;
+      _users      = 0;
+      _wanted     = 0;
+      _lastUse    = 0;
+      _oggOffset  = 0;
+      _oggSize    = 0;
       start       = 0;
       end         = 0;
       loopstart   = 0;
@@ -618,47 +638,102 @@ Sample::Sample(SFont* s)
 
 Sample::~Sample()
       {
-      delete[] data;
+      if (_ownData)
+            delete[] data;
       }
 
 //---------------------------------------------------------
 //   load
+//    Compressed samples are handed to the decoder if it
+//    runs in the background, all others are loaded right
+//    away.
 //---------------------------------------------------------
 
-void Sample::load()
+void Sample::load(bool urgent)
       {
-      if (!_valid || data)
+      if (!_valid || _state.load(std::memory_order_acquire) != UNLOADED)
             return;
-      QFile fd(sf->get_name());
-      if (!fd.open(QIODevice::ReadOnly))
+#ifdef SOUNDFONT3
+      if (compressed() && sf->fluid()->decodeInBackground()) {
+            request(urgent);
             return;
-      if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
-            if (!fd.seek(sf->samplePos() + start))
-                  return;
             }
-      else {
-            if (!fd.seek(sf->samplePos() + start * sizeof(short)))
-                  return;
+#else
+      Q_UNUSED(urgent);
+#endif
+      loadNow();
+      }
+
+//---------------------------------------------------------
+//   loadNow
+//    return true if the sample was loaded by this call
+//---------------------------------------------------------
+
+bool Sample::loadNow()
+      {
+      int state = UNLOADED;
+      if (!_valid || !_state.compare_exchange_strong(state, LOADING))
+            return false;
+      if (!loadData()) {
+            setValid(false);
+            _state.store(UNLOADED, std::memory_order_release);
+            return false;
             }
-      unsigned int size = end - start;
+      optimize();
+      touch();
+      _state.store(LOADED, std::memory_order_release);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   loadData
+//    Uncompressed samples are used in place in the mapped
+//    font if possible.
+//---------------------------------------------------------
 
+bool Sample::loadData()
+      {
       if (sampletype & FLUID_SAMPLETYPE_OGG_VORBIS) {
 #ifdef SOUNDFONT3
-            std::vector<char> p;
-            p.resize(size);
-            if (fd.read(p.data(), size) != size) {
-                  qDebug("read %d failed", size);
-                  return;
+            if (_oggSize == 0) {
+                  // first decoding, start and end are changed to frames
+                  _oggOffset = start;
+                  _oggSize   = end - start;
                   }
-            decompressOggVorbis(p.data(), size);
+            const uchar* p = sf->mappedData(sf->samplePos() + _oggOffset);
+            if (p)
+                  return decompressOggVorbis((char*)p, _oggSize);
+            std::vector<char> buf(_oggSize);
+            if (!sf->readSampleData(sf->samplePos() + _oggOffset, buf.data(), _oggSize)) {
+                  qDebug("read %d failed", _oggSize);
+                  return false;
+                  }
+            return decompressOggVorbis(buf.data(), _oggSize);
+#else
+            return false;
 #endif
             }
+
+      unsigned int size = end - start;
+      qint64 pos        = sf->samplePos() + start * sizeof(short);
+      const uchar* p    = sf->mappedData(pos);
+
+      if (p && QSysInfo::ByteOrder == QSysInfo::LittleEndian && (quintptr(p) % alignof(short)) == 0) {
+            data     = (short*)p;
+            _ownData = false;
+            }
       else {
-            data = new short[size];
+            data     = new short[size];
+            _ownData = true;
             size *= sizeof(short);
 
-            if (fd.read((char*)data, size) != size)
-                  return;
+            if (p)
+                  memcpy(data, p, size);
+            else if (!sf->readSampleData(pos, (char*)data, size)) {
+                  delete[] data;
+                  data = 0;
+                  return false;
+                  }
 
             if (QSysInfo::ByteOrder == QSysInfo::BigEndian) {
                   unsigned char hi, lo;
@@ -672,12 +747,29 @@ void Sample::load()
                         data[i] = s;
                         }
                   }
-            end       -= (start + 1);       // marks last sample, contrary to SF spec.
-            loopstart -= start;
-            loopend   -= start;
-            start      = 0;
             }
-      optimize();
+      end       -= (start + 1);       // marks last sample, contrary to SF spec.
+      loopstart -= start;
+      loopend   -= start;
+      start      = 0;
+      return true;
+      }
+
+//---------------------------------------------------------
+//   acquire
+//    a voice starts playing the sample, return false if
+//    it is not loaded
+//---------------------------------------------------------
+
+bool Sample::acquire()
+      {
+      _users.fetch_add(1);
+      if (_state.load() == LOADED) {
+            touch();
+            return true;
+            }
+      _users.fetch_sub(1);
+      return false;
       }
 
 //---------------------------------------------------------
@@ -782,12 +874,24 @@ bool SFont::load()
             f.close();
             return false;
             }
-      f.close();
+      // the samples are read from the mapped file when needed
+      _map = f.map(0, f.size());
       /* sort preset list by bank, preset # */
       qSort(presets.begin(), presets.end(), preset_compare);
       return true;
       }
 
+//---------------------------------------------------------
+//   readSampleData
+//    if the font could not be mapped
+//---------------------------------------------------------
+
+bool SFont::readSampleData(qint64 pos, char* buf, qint64 size)
+      {
+      QMutexLocker locker(&_fileMutex);
+      return f.seek(pos) && f.read(buf, size) == size;
+      }
+
 //---------------------------------------------------------
 //   READW
 //---------------------------------------------------------
@@ -23,6 +23,7 @@
 #ifndef _FLUID_DEFSFONT_H
 #define _FLUID_DEFSFONT_H
 
+#include <atomic>
 #include "config.h"
 #include "fluid.h"
 
@@ -51,7 +52,9 @@ struct SFVersion {            // version structure
 
 class SFont {
       Fluid* synth;
-      QFile f;
+      QFile f;                      // kept open while the font is loaded
+      const uchar* _map;            // the whole file, if it could be mapped
+      QMutex _fileMutex;            // for reading f if it is not mapped
       unsigned samplepos;           // the position in the file at which the sample data starts
       unsigned samplesize;          // the size of the sample data
 
@@ -110,6 +113,10 @@ class SFont {
       bool read(const QString& file);
 
       int load_sampledata();
+      bool readSampleData(qint64 pos, char* buf, qint64 size);
+      const uchar* mappedData(qint64 pos) const { return _map ? _map + pos : 0; }
+      const QList<Sample*>& samples() const     { return sample; }
+      Fluid* fluid() const                      { return synth; }
       unsigned int samplePos() const            { return samplepos;  }
       int id() const                            { return _id; }
       void setId(int i)                         { _id = i;    }
@@ -130,7 +137,22 @@ class SFont {
 //---------------------------------------------------------
 
 class Sample {
+      enum {
+            UNLOADED, LOADING, LOADED, EVICTING
+            };
       bool _valid;
+      bool _ownData;                // data was allocated, it does not point into the mapped font
+      std::atomic<int> _state;
+      std::atomic<int> _users;      // voices playing the sample
+      std::atomic<int> _wanted;     // 1: decode in background, 2: a note waits for it
+      std::atomic<unsigned> _lastUse;
+      unsigned _oggOffset;          // compressed data, start and end are decoded frames
+      unsigned _oggSize;
+
+      static std::atomic<unsigned> useCount;
+
+      bool loadData();
+      void touch()          { _lastUse.store(++useCount, std::memory_order_relaxed); }
 
    public:
       SFont* sf;
@@ -157,15 +179,54 @@ class Sample {
       ~Sample();
 
       bool inRom() const;
+      bool compressed() const { return sampletype & FLUID_SAMPLETYPE_OGG_VORBIS; }
       void optimize();
-      void load();
+      void load(bool urgent = false);
+      bool loadNow();
+      bool loaded() const   { return _state.load(std::memory_order_acquire) == LOADED; }
+      bool acquire();
+      void release()        { _users.fetch_sub(1); }
       bool valid() const    { return _valid; }
       void setValid(bool v) { _valid = v; }
 #ifdef SOUNDFONT3
       bool decompressOggVorbis(char* p, int size);
+      void request(bool urgent);
+      int wanted() const       { return _wanted.load(std::memory_order_relaxed); }
+      void clearWanted()       { _wanted.store(0, std::memory_order_relaxed); }
+      unsigned lastUse() const { return _lastUse.load(std::memory_order_relaxed); }
+      size_t decodedSize() const;
+      bool evict();
 #endif
       };
 
+#ifdef SOUNDFONT3
+//---------------------------------------------------------
+//   SampleDecoder
+//    Decodes the compressed samples of the fonts of one
+//    Fluid instance in the background when they are
+//    requested. Decoded samples which were not played for
+//    the longest time are dropped again if they need more
+//    than the memory budget.
+//---------------------------------------------------------
+
+class SampleDecoder : public QThread {
+      QList<SFont*> _fonts;
+      QMutex _mutex;
+      QWaitCondition _wait;
+      std::atomic<bool> _quit { false };
+
+      virtual void run() override;
+      void evict();
+
+   public:
+      ~SampleDecoder();
+      void addFont(SFont*);
+      void removeFont(SFont*);
+      void startDecoding();
+      void stopDecoding();
+      };
+#endif
+
 //---------------------------------------------------------
 //   Zone
 //---------------------------------------------------------
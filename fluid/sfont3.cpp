@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
+#include <vector>
 #include "sfont.h"
 #include "audiofile/audiofile.h"
 
@@ -13,7 +15,7 @@ namespace FluidS {
 bool Sample::decompressOggVorbis(char* src, int size)
       {
       AudioFile af;
-      QByteArray ba(src, size);
+      QByteArray ba = QByteArray::fromRawData(src, size);
 
       start = 0;
       end   = 0;
@@ -23,10 +25,12 @@ bool Sample::decompressOggVorbis(char* src, int size)
             }
       int frames = af.frames();
       data = new short[frames * af.channels()];
+      _ownData = true;
       if (frames != af.readData(data, frames)) {
             qDebug("Sample read failed: %s", af.error());
             delete[] data;
             data = 0;
+            return false;
             }
       end = frames - 1;
 
@@ -48,4 +52,160 @@ bool Sample::decompressOggVorbis(char* src, int size)
 
       return true;
       }
+
+//---------------------------------------------------------
+//   request
+//    ask the decoder for the sample
+//---------------------------------------------------------
+
+void Sample::request(bool urgent)
+      {
+      int w = urgent ? 2 : 1;
+      int cur = _wanted.load(std::memory_order_relaxed);
+      while (cur < w && !_wanted.compare_exchange_weak(cur, w))
+            ;
+      }
+
+//---------------------------------------------------------
+//   decodedSize
+//---------------------------------------------------------
+
+size_t Sample::decodedSize() const
+      {
+      return loaded() ? (end + 1) * sizeof(short) : 0;
+      }
+
+//---------------------------------------------------------
+//   evict
+//    drop the decoded data if no voice plays the sample
+//---------------------------------------------------------
+
+bool Sample::evict()
+      {
+      int state = LOADED;
+      if (!_state.compare_exchange_strong(state, EVICTING))
+            return false;
+      if (_users.load() > 0) {
+            _state.store(LOADED, std::memory_order_release);
+            return false;
+            }
+      delete[] data;
+      data = 0;
+      _state.store(UNLOADED, std::memory_order_release);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   SampleDecoder
+//---------------------------------------------------------
+
+static const size_t DECODED_SAMPLES_BUDGET = 512 * 1024 * 1024;
+
+SampleDecoder::~SampleDecoder()
+      {
+      stopDecoding();
+      }
+
+//---------------------------------------------------------
+//   addFont
+//---------------------------------------------------------
+
+void SampleDecoder::addFont(SFont* sf)
+      {
+      QMutexLocker locker(&_mutex);
+      _fonts.append(sf);
+      }
+
+//---------------------------------------------------------
+//   removeFont
+//    the decoder does not access the font after this
+//---------------------------------------------------------
+
+void SampleDecoder::removeFont(SFont* sf)
+      {
+      QMutexLocker locker(&_mutex);
+      _fonts.removeAll(sf);
+      }
+
+//---------------------------------------------------------
+//   startDecoding
+//---------------------------------------------------------
+
+void SampleDecoder::startDecoding()
+      {
+      if (isRunning())
+            return;
+      _quit = false;
+      start(QThread::LowPriority);
+      }
+
+//---------------------------------------------------------
+//   stopDecoding
+//---------------------------------------------------------
+
+void SampleDecoder::stopDecoding()
+      {
+      _quit = true;
+      _wait.wakeAll();
+      wait();
+      }
+
+//---------------------------------------------------------
+//   evict
+//    drop the least recently played samples until the
+//    decoded ones fit into the budget again
+//---------------------------------------------------------
+
+void SampleDecoder::evict()
+      {
+      size_t size = 0;
+      std::vector<Sample*> sl;
+      for (SFont* sf : _fonts) {
+            for (Sample* s : sf->samples()) {
+                  if (s->compressed() && s->loaded()) {
+                        size += s->decodedSize();
+                        sl.push_back(s);
+                        }
+                  }
+            }
+      if (size <= DECODED_SAMPLES_BUDGET)
+            return;
+      std::sort(sl.begin(), sl.end(), [](Sample* a, Sample* b) { return a->lastUse() < b->lastUse(); });
+      for (Sample* s : sl) {
+            size_t n = s->decodedSize();
+            if (s->evict())
+                  size -= n;
+            if (size <= DECODED_SAMPLES_BUDGET)
+                  break;
+            }
+      }
+
+//---------------------------------------------------------
+//   run
+//    Samples a note is waiting for are decoded first,
+//    between the others the list is checked again.
+//---------------------------------------------------------
+
+void SampleDecoder::run()
+      {
+      QMutexLocker locker(&_mutex);
+      while (!_quit) {
+            Sample* next = 0;
+            for (SFont* sf : _fonts) {
+                  for (Sample* s : sf->samples()) {
+                        int w = s->wanted();
+                        if (w && (!next || w > next->wanted()))
+                              next = s;
+                        }
+                  }
+            if (!next) {
+                  _wait.wait(&_mutex, 10);
+                  continue;
+                  }
+            if (next->loadNow())
+                  evict();
+            next->clearWanted();
+            }
+      }
+
 } // namespace
@@ -141,6 +141,7 @@ void Voice::init(Sample* _sample, Channel* _channel, int _key, int _vel,
       channel        = _channel;
       mod_count      = 0;
       sample         = _sample;
+      _holdsSample   = true;          // acquired in Preset::noteon()
       ticks          = 0;
       debug          = 0;
       has_looped     = false; // Will be set during voice_write when the 2nd loop point is reached
@@ -1520,6 +1521,10 @@ void Voice::off()
       modenv_section = FLUID_VOICE_ENVFINISHED;
       modenv_count   = 0;
       status         = FLUID_VOICE_OFF;
+      if (_holdsSample) {
+            sample->release();
+            _holdsSample = false;
+            }
       _fluid->freeVoice(this);
       _cachedFrames = 0;
       _initialCacheFrames = 0;
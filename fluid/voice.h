@@ -75,6 +75,7 @@ class Voice
       unsigned _cachedFrames = 0;
       //Keeps number of the initially cached frames. It's used to calculate actual shift in cache arrays for setting cache to output stream.
       unsigned _initialCacheFrames = 0;
+      bool _holdsSample = false;      // the sample was acquired for this voice
       //Cache arrays keep actual calculated data after applying effects. Its size is twice bigger than framesBuffer (2 channels).
       std::vector<float> _cacheOut;
       std::vector<float> _cacheReverb;
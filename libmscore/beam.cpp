@@ -677,7 +677,7 @@ static QHash<int, Bm> bMetrics;
 
 #define B(a,b,c,d,e) bMetrics[Bm::key(a, b, c)] = Bm(d, e);
 
-static void initBeamMetrics()
+static bool initBeamMetrics()
       {
       // up  step1 step2 stemLen1 slant
       //                 (- up)   (- up)
@@ -1051,6 +1051,7 @@ static void initBeamMetrics()
       B(0, -3,  2, 18, 4);
       B(0, -3,  3, 18, 5);
       B(0, -3,  4, 21, 5);
+      return true;
       }
 
 //---------------------------------------------------------
@@ -1060,12 +1061,10 @@ static void initBeamMetrics()
 
 static Bm beamMetric1(bool up, char l1, char l2)
       {
-      static int initialized = false;
-      if (!initialized) {
-            initBeamMetrics();
-            initialized = true;
-            }
-      return bMetrics[Bm::key(up, l1, l2)];
+      // a static initializer runs once even if scores are laid out in several threads
+      static const bool initialized = initBeamMetrics();
+      Q_UNUSED(initialized);
+      return bMetrics.value(Bm::key(up, l1, l2));
       }
 
 //---------------------------------------------------------
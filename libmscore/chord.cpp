@@ -1028,91 +1028,100 @@ void Chord::read(XmlReader& e)
 
 bool Chord::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (tag == "Note") {
-            Note* note = new Note(score());
-            // the note needs to know the properties of the track it belongs to
-            note->setTrack(track());
-            note->setChord(this);
-            note->read(e);
-            add(note);
-            }
-      else if (ChordRest::readProperties(e))
-            ;
-      else if (tag == "Stem") {
-            Stem* s = new Stem(score());
-            s->read(e);
-            add(s);
-            }
-      else if (tag == "Hook") {
-            _hook = new Hook(score());
-            _hook->read(e);
-            add(_hook);
-            }
-      else if (tag == "appoggiatura") {
-            _noteType = NoteType::APPOGGIATURA;
-            e.readNext();
-            }
-      else if (tag == "acciaccatura") {
-            _noteType = NoteType::ACCIACCATURA;
-            e.readNext();
-            }
-      else if (tag == "grace4") {
-            _noteType = NoteType::GRACE4;
-            e.readNext();
-            }
-      else if (tag == "grace16") {
-            _noteType = NoteType::GRACE16;
-            e.readNext();
-            }
-      else if (tag == "grace32") {
-            _noteType = NoteType::GRACE32;
-            e.readNext();
-            }
-      else if (tag == "grace8after") {
-            _noteType = NoteType::GRACE8_AFTER;
-            e.readNext();
-            }
-      else if (tag == "grace16after") {
-            _noteType = NoteType::GRACE16_AFTER;
-            e.readNext();
-            }
-      else if (tag == "grace32after") {
-            _noteType = NoteType::GRACE32_AFTER;
-            e.readNext();
-            }
-      else if (tag == "StemSlash") {
-            StemSlash* ss = new StemSlash(score());
-            ss->read(e);
-            add(ss);
-            }
-      else if (readProperty(tag, e, Pid::STEM_DIRECTION))
-            ;
-      else if (tag == "noStem")
-            _noStem = e.readInt();
-      else if (tag == "Arpeggio") {
-            _arpeggio = new Arpeggio(score());
-            _arpeggio->setTrack(track());
-            _arpeggio->read(e);
-            _arpeggio->setParent(this);
-            }
-      else if (tag == "Tremolo") {
-            _tremolo = new Tremolo(score());
-            _tremolo->setTrack(track());
-            _tremolo->read(e);
-            _tremolo->setParent(this);
-            _tremolo->setDurationType(durationType());
-            }
-      else if (tag == "tickOffset")       // obsolete
-            ;
-      else if (tag == "ChordLine") {
-            ChordLine* cl = new ChordLine(score());
-            cl->read(e);
-            add(cl);
+      switch (e.tagId()) {
+            case XmlTag::NOTE:
+                  {
+                  Note* note = new Note(score());
+                  // the note needs to know the properties of the track it belongs to
+                  note->setTrack(track());
+                  note->setChord(this);
+                  note->read(e);
+                  add(note);
+                  }
+                  break;
+            case XmlTag::STEM:
+                  {
+                  Stem* s = new Stem(score());
+                  s->read(e);
+                  add(s);
+                  }
+                  break;
+            case XmlTag::HOOK:
+                  _hook = new Hook(score());
+                  _hook->read(e);
+                  add(_hook);
+                  break;
+            case XmlTag::APPOGGIATURA:
+                  _noteType = NoteType::APPOGGIATURA;
+                  e.readNext();
+                  break;
+            case XmlTag::ACCIACCATURA:
+                  _noteType = NoteType::ACCIACCATURA;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE4:
+                  _noteType = NoteType::GRACE4;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE16:
+                  _noteType = NoteType::GRACE16;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE32:
+                  _noteType = NoteType::GRACE32;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE8_AFTER:
+                  _noteType = NoteType::GRACE8_AFTER;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE16_AFTER:
+                  _noteType = NoteType::GRACE16_AFTER;
+                  e.readNext();
+                  break;
+            case XmlTag::GRACE32_AFTER:
+                  _noteType = NoteType::GRACE32_AFTER;
+                  e.readNext();
+                  break;
+            case XmlTag::STEM_SLASH:
+                  {
+                  StemSlash* ss = new StemSlash(score());
+                  ss->read(e);
+                  add(ss);
+                  }
+                  break;
+            case XmlTag::STEM_DIRECTION:
+                  readProperty(e, Pid::STEM_DIRECTION);
+                  break;
+            case XmlTag::NO_STEM:
+                  _noStem = e.readInt();
+                  break;
+            case XmlTag::ARPEGGIO:
+                  _arpeggio = new Arpeggio(score());
+                  _arpeggio->setTrack(track());
+                  _arpeggio->read(e);
+                  _arpeggio->setParent(this);
+                  break;
+            case XmlTag::TREMOLO:
+                  _tremolo = new Tremolo(score());
+                  _tremolo->setTrack(track());
+                  _tremolo->read(e);
+                  _tremolo->setParent(this);
+                  _tremolo->setDurationType(durationType());
+                  break;
+            case XmlTag::TICK_OFFSET:     // obsolete
+                  break;
+            case XmlTag::CHORD_LINE:
+                  {
+                  ChordLine* cl = new ChordLine(score());
+                  cl->read(e);
+                  add(cl);
+                  }
+                  break;
+            default:
+                  // none of the tags above is handled by ChordRest
+                  return ChordRest::readProperties(e);
             }
-      else
-            return false;
       return true;
       }
 
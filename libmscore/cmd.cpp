@@ -152,11 +152,27 @@ void Score::undoRedo(bool undo, EditData* ed)
             undoStack()->undo(ed);
       else
             undoStack()->redo(ed);
+      const CmdState cs = cmdState();     // update() resets the tick range
       update();
-      masterScore()->setPlaylistDirty();  // TODO: flag all individual operations
+      setPlaylistDirty(cs);
       updateSelection();
       }
 
+//---------------------------------------------------------
+//   setPlaylistDirty
+//    Flag the playlist as changed in the tick range of the
+//    last command. Operations which change playback beyond
+//    their own position flag the whole playlist themselves.
+//---------------------------------------------------------
+
+void Score::setPlaylistDirty(const CmdState& cs)
+      {
+      if (cs.layoutRange())
+            masterScore()->setPlaylistDirty(cs.startTick(), cs.endTick());
+      else
+            masterScore()->setPlaylistDirty();
+      }
+
 //---------------------------------------------------------
 //   endCmd
 ///   End a GUI command by (if \a undo) ending a user-visble undo
@@ -176,6 +192,7 @@ void Score::endCmd(bool rollback)
       if (rollback)
             undoStack()->current()->unwind();
 
+      const CmdState cs = cmdState();     // update() resets the tick range
       update();
 
       if (MScore::debugMode)
@@ -184,7 +201,7 @@ void Score::endCmd(bool rollback)
       undoStack()->endMacro(noUndo);
 
       if (dirty()) {
-            masterScore()->setPlaylistDirty();  // TODO: flag individual operations
+            setPlaylistDirty(cs);
             masterScore()->setAutosaveDirty(true);
             }
       MuseScoreCore::mscoreCore->endCmd();
@@ -595,132 +595,155 @@ void Element::writeProperties(XmlWriter& xml) const
 
 bool Element::readProperties(XmlReader& e)
       {
-      const QStringRef& tag(e.name());
-
-      if (readProperty(tag, e, Pid::SIZE_SPATIUM_DEPENDENT))
-            ;
-      else if (readProperty(tag, e, Pid::OFFSET))
-            ;
-      else if (readProperty(tag, e, Pid::MIN_DISTANCE))
-            ;
-      else if (readProperty(tag, e, Pid::AUTOPLACE))
-            ;
-      else if (tag == "track")
-            setTrack(e.readInt() + e.trackOffset());
-      else if (tag == "color")
-            setColor(e.readColor());
-      else if (tag == "visible")
-            setVisible(e.readInt());
-      else if (tag == "selected") // obsolete
-            e.readInt();
-      else if ((tag == "linked") || (tag == "linkedMain")) {
-            Staff* s = staff();
-            if (!s) {
-                  s = score()->staff(e.track() / VOICES);
+      const XmlTag tag = e.tagId();
+
+      switch (tag) {
+            case XmlTag::SIZE_SPATIUM_DEPENDENT:
+                  readProperty(e, Pid::SIZE_SPATIUM_DEPENDENT);
+                  break;
+            case XmlTag::OFFSET:
+                  readProperty(e, Pid::OFFSET);
+                  break;
+            case XmlTag::MIN_DISTANCE:
+                  readProperty(e, Pid::MIN_DISTANCE);
+                  break;
+            case XmlTag::AUTOPLACE:
+                  readProperty(e, Pid::AUTOPLACE);
+                  break;
+            case XmlTag::TRACK:
+                  setTrack(e.readInt() + e.trackOffset());
+                  break;
+            case XmlTag::COLOR:
+                  setColor(e.readColor());
+                  break;
+            case XmlTag::VISIBLE:
+                  setVisible(e.readInt());
+                  break;
+            case XmlTag::SELECTED:        // obsolete
+                  e.readInt();
+                  break;
+            case XmlTag::LINKED:
+            case XmlTag::LINKED_MAIN:
+                  {
+                  Staff* s = staff();
                   if (!s) {
-                        qWarning("Element::readProperties: linked element's staff not found (%s)", name());
-                        e.skipCurrentElement();
-                        return true;
+                        s = score()->staff(e.track() / VOICES);
+                        if (!s) {
+                              qWarning("Element::readProperties: linked element's staff not found (%s)", name());
+                              e.skipCurrentElement();
+                              return true;
+                              }
                         }
-                  }
-            if (tag == "linkedMain") {
-                  _links = new LinkedElements(score());
-                  _links->push_back(this);
-                  e.addLink(s, _links);
-                  e.readNext();
-                  }
-            else {
-                  Staff* ls = s->links() ? toStaff(s->links()->mainElement()) : nullptr;
-                  bool linkedIsMaster = ls ? ls->score()->isMaster() : false;
-                  Location loc = e.location(true);
-                  if (ls)
-                        loc.setStaff(ls->idx());
-                  Location mainLoc = Location::relative();
-                  bool locationRead = false;
-                  int localIndexDiff = 0;
-                  while (e.readNextStartElement()) {
-                        const QStringRef& ntag(e.name());
-
-                        if (ntag == "score") {
-                              QString val(e.readElementText());
-                              if (val == "same")
-                                    linkedIsMaster = score()->isMaster();
+                  if (tag == XmlTag::LINKED_MAIN) {
+                        _links = new LinkedElements(score());
+                        _links->push_back(this);
+                        e.addLink(s, _links);
+                        e.readNext();
+                        }
+                  else {
+                        Staff* ls = s->links() ? toStaff(s->links()->mainElement()) : nullptr;
+                        bool linkedIsMaster = ls ? ls->score()->isMaster() : false;
+                        Location loc = e.location(true);
+                        if (ls)
+                              loc.setStaff(ls->idx());
+                        Location mainLoc = Location::relative();
+                        bool locationRead = false;
+                        int localIndexDiff = 0;
+                        while (e.readNextStartElement()) {
+                              const QStringRef& ntag(e.name());
+
+                              if (ntag == "score") {
+                                    QString val(e.readElementText());
+                                    if (val == "same")
+                                          linkedIsMaster = score()->isMaster();
+                                    }
+                              else if (ntag == "location") {
+                                    mainLoc.read(e);
+                                    mainLoc.toAbsolute(loc);
+                                    locationRead = true;
+                                    }
+                              else if (ntag == "indexDiff")
+                                    localIndexDiff = e.readInt();
+                              else
+                                    e.unknown();
                               }
-                        else if (ntag == "location") {
-                              mainLoc.read(e);
-                              mainLoc.toAbsolute(loc);
-                              locationRead = true;
+                        if (!locationRead)
+                              mainLoc = loc;
+                        LinkedElements* link = e.getLink(linkedIsMaster, mainLoc, localIndexDiff);
+                        if (link) {
+                              ScoreElement* linked = link->mainElement();
+                              if (linked->type() == type())
+                                    linkTo(linked);
+                              else
+                                    qWarning("Element::readProperties: linked elements have different types: %s, %s. Input file corrupted?", name(), linked->name());
                               }
-                        else if (ntag == "indexDiff")
-                              localIndexDiff = e.readInt();
-                        else
-                              e.unknown();
-                        }
-                  if (!locationRead)
-                        mainLoc = loc;
-                  LinkedElements* link = e.getLink(linkedIsMaster, mainLoc, localIndexDiff);
-                  if (link) {
-                        ScoreElement* linked = link->mainElement();
-                        if (linked->type() == type())
-                              linkTo(linked);
-                        else
-                              qWarning("Element::readProperties: linked elements have different types: %s, %s. Input file corrupted?", name(), linked->name());
+                        if (!_links)
+                              qWarning("Element::readProperties: could not link %s at staff %d", name(), mainLoc.staff() + 1);
                         }
-                  if (!_links)
-                        qWarning("Element::readProperties: could not link %s at staff %d", name(), mainLoc.staff() + 1);
-                  }
-            }
-      else if (tag == "lid") {
-            if (score()->mscVersion() >= 301) {
-                  e.skipCurrentElement();
-                  return true;
-                  }
-            int id = e.readInt();
-            _links = e.linkIds().value(id);
-            if (!_links) {
-                  if (!score()->isMaster())   // DEBUG
-                        qDebug("---link %d not found (%d)", id, e.linkIds().size());
-                  _links = new LinkedElements(score(), id);
-                  e.linkIds().insert(id, _links);
                   }
+                  break;
+            case XmlTag::LID:
+                  {
+                  if (score()->mscVersion() >= 301) {
+                        e.skipCurrentElement();
+                        return true;
+                        }
+                  int id = e.readInt();
+                  _links = e.linkIds().value(id);
+                  if (!_links) {
+                        if (!score()->isMaster())   // DEBUG
+                              qDebug("---link %d not found (%d)", id, e.linkIds().size());
+                        _links = new LinkedElements(score(), id);
+                        e.linkIds().insert(id, _links);
+                        }
 #ifndef NDEBUG
-            else {
-                  for (ScoreElement* eee : *_links) {
-                        Element* ee = static_cast<Element*>(eee);
-                        if (ee->type() != type()) {
-                              qFatal("link %s(%d) type mismatch %s linked to %s",
-                                 ee->name(), id, ee->name(), name());
+                  else {
+                        for (ScoreElement* eee : *_links) {
+                              Element* ee = static_cast<Element*>(eee);
+                              if (ee->type() != type()) {
+                                    qFatal("link %s(%d) type mismatch %s linked to %s",
+                                       ee->name(), id, ee->name(), name());
+                                    }
                               }
                         }
-                  }
 #endif
-            Q_ASSERT(!_links->contains(this));
-            _links->append(this);
-            }
-      else if (tag == "tick") {
-            int val = e.readInt();
-            if (val >= 0)
-                  e.setTick(Fraction::fromTicks(score()->fileDivision(val)));       // obsolete
-            }
-      else if (tag == "pos")             // obsolete
-            readProperty(e, Pid::OFFSET);
-      else if (tag == "voice")
-            setTrack((_track/VOICES)*VOICES + e.readInt());
-      else if (tag == "tag") {
-            QString val(e.readElementText());
-            for (int i = 1; i < MAX_TAGS; i++) {
-                  if (score()->layerTags()[i] == val) {
-                        _tag = 1 << i;
-                        break;
+                  Q_ASSERT(!_links->contains(this));
+                  _links->append(this);
+                  }
+                  break;
+            case XmlTag::TICK:
+                  {
+                  int val = e.readInt();
+                  if (val >= 0)
+                        e.setTick(Fraction::fromTicks(score()->fileDivision(val)));       // obsolete
+                  }
+                  break;
+            case XmlTag::POS:             // obsolete
+                  readProperty(e, Pid::OFFSET);
+                  break;
+            case XmlTag::VOICE:
+                  setTrack((_track/VOICES)*VOICES + e.readInt());
+                  break;
+            case XmlTag::TAG:
+                  {
+                  QString val(e.readElementText());
+                  for (int i = 1; i < MAX_TAGS; i++) {
+                        if (score()->layerTags()[i] == val) {
+                              _tag = 1 << i;
+                              break;
+                              }
                         }
                   }
+                  break;
+            case XmlTag::PLACEMENT:
+                  readProperty(e, Pid::PLACEMENT);
+                  break;
+            case XmlTag::Z:
+                  setZ(e.readInt());
+                  break;
+            default:
+                  return false;
             }
-      else if (readProperty(tag, e, Pid::PLACEMENT))
-            ;
-      else if (tag == "z")
-            setZ(e.readInt());
-      else
-            return false;
       return true;
       }
 
@@ -274,6 +274,9 @@ class Element : public ScoreElement {
 
       virtual int subtype() const                 { return -1; }  // for select gui
 
+      // draw() only reads the element and the score: the pages of a
+      // score are drawn concurrently for image export. Caches filled
+      // on first use must be guarded (see Image, StaffType, ScoreFont)
       virtual void draw(QPainter*) const {}
       void drawAt(QPainter*p, const QPointF& pt) const { p->translate(pt); draw(p); p->translate(-pt);}
 
@@ -128,6 +128,74 @@ bool Excerpt::operator==(const Excerpt& e) const
 //---------------------------------------------------------
 
 void Excerpt::createExcerpt(Excerpt* excerpt)
+      {
+      fillPartScore(excerpt);
+
+      MasterScore* oscore = excerpt->oscore();
+      oscore->rebuildMidiMapping();
+      oscore->updateChannel();
+
+      Score* score = excerpt->partScore();
+      score->setLayoutAll();
+      score->doLayout();
+      }
+
+//---------------------------------------------------------
+//   createExcerpts
+//    Create the part scores of several excerpts at once.
+//    The midi mapping of the score is rebuilt once and every
+//    part is laid out once, instead of relayouting all parts
+//    for every new one. With undo the excerpts are added in
+//    one command, without (file conversion) they are added
+//    directly.
+//---------------------------------------------------------
+
+void Excerpt::createExcerpts(MasterScore* oscore, const QList<Excerpt*>& excerpts, bool undo)
+      {
+      for (Excerpt* e : excerpts) {
+            if (!e->partScore()) {
+                  Score* nscore = new Score(oscore);
+                  e->setPartScore(nscore);
+                  nscore->style().set(Sid::createMultiMeasureRests, true);
+                  }
+            }
+      if (undo)
+            oscore->startCmd();
+      for (Excerpt* e : excerpts) {
+            // add the excerpt while its part score is still empty:
+            // addExcerpt() appends the parts of all linked staves
+            // of the part score to the excerpt
+            if (undo)
+                  oscore->undo(new AddExcerpt(e));
+            else
+                  oscore->addExcerpt(e);
+            fillPartScore(e);
+            }
+      oscore->rebuildMidiMapping();
+      oscore->updateChannel();
+
+      if (undo) {
+            // endCmd() lays out the score and all parts
+            oscore->setLayoutAll();
+            oscore->endCmd();
+            }
+      else {
+            for (Excerpt* e : excerpts) {
+                  Score* score = e->partScore();
+                  score->setLayoutAll();
+                  score->doLayout();
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   fillPartScore
+//    Clone the parts of the excerpt into its part score.
+//    The part score is only laid out if transposing
+//    instruments need it; the caller lays it out afterwards.
+//---------------------------------------------------------
+
+void Excerpt::fillPartScore(Excerpt* excerpt)
       {
       MasterScore* oscore = excerpt->oscore();
       Score* score        = excerpt->partScore();
@@ -215,12 +283,12 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
             score->setMetaTag("partName", partLabel);
             }
 
-      // initial layout of score
       score->addLayoutFlags(LayoutFlag::FIX_PITCH_VELO);
-      score->doLayout();
 
       // handle transposing instruments
       if (oscore->styleB(Sid::concertPitch) != score->styleB(Sid::concertPitch)) {
+            // the harmonies are found through the multi measure rests
+            score->doLayout();
             for (const Staff* staff : score->staves()) {
                   if (staff->staffType(Fraction(0,1))->group() == StaffGroup::PERCUSSION)
                         continue;
@@ -278,13 +346,7 @@ void Excerpt::createExcerpt(Excerpt* excerpt)
             score->styleChanged();
             }
 
-      // second layout of score
       score->setPlaylistDirty();
-      oscore->rebuildMidiMapping();
-      oscore->updateChannel();
-
-      score->setLayoutAll();
-      score->doLayout();
       }
 
 //---------------------------------------------------------
@@ -27,6 +27,15 @@ static bool defaultAutoScale        = false;
 static bool defaultLockAspectRatio  = true;
 static bool defaultSizeIsSpatium    = true;
 
+//---------------------------------------------------------
+//   bufferMutex
+//    guards the cached rendering and the svg renderer:
+//    the pages of a score can be drawn in parallel
+//    (see MuseScore::savePng)
+//---------------------------------------------------------
+
+static QMutex bufferMutex;
+
 //---------------------------------------------------------
 //   Image
 //---------------------------------------------------------
@@ -107,6 +116,23 @@ QSizeF Image::imageSize() const
       return imageType == ImageType::RASTER ? rasterDoc->size() : svgDoc->defaultSize();
       }
 
+//---------------------------------------------------------
+//   scaledImage
+//    return the raster image scaled to size, the last
+//    result is cached. A QImage, unlike a QPixmap, can be
+//    drawn outside of the gui thread.
+//---------------------------------------------------------
+
+QImage Image::scaledImage(const QSize& size) const
+      {
+      QMutexLocker locker(&bufferMutex);
+      if ((buffer.size() != size || _dirty) && rasterDoc && !rasterDoc->isNull()) {
+            buffer = rasterDoc->scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            _dirty = false;
+            }
+      return buffer;
+      }
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
@@ -117,8 +143,11 @@ void Image::draw(QPainter* painter) const
       if (imageType == ImageType::SVG) {
             if (!svgDoc)
                   emptyImage = true;
-            else
+            else {
+                  // the renderer keeps state while drawing
+                  QMutexLocker locker(&bufferMutex);
                   svgDoc->render(painter, bbox());
+                  }
             }
       else if (imageType == ImageType::RASTER) {
             if (rasterDoc == nullptr)
@@ -133,21 +162,18 @@ void Image::draw(QPainter* painter) const
                   if (score()->printing() && !MScore::svgPrinting) {
                         // use original image size for printing, but not for svg for reasonable file size.
                         painter->scale(s.width() / rasterDoc->width(), s.height() / rasterDoc->height());
-                        painter->drawPixmap(QPointF(0, 0), QPixmap::fromImage(*rasterDoc));
+                        painter->drawImage(QPointF(0, 0), *rasterDoc);
                         }
                   else {
                         QTransform t = painter->transform();
                         QSize ss = QSizeF(s.width() * t.m11(), s.height() * t.m22()).toSize();
                         t.setMatrix(1.0, t.m12(), t.m13(), t.m21(), 1.0, t.m23(), t.m31(), t.m32(), t.m33());
                         painter->setWorldTransform(t);
-                        if ((buffer.size() != ss || _dirty) && rasterDoc && !rasterDoc->isNull()) {
-                              buffer = QPixmap::fromImage(rasterDoc->scaled(ss, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
-                              _dirty = false;
-                              }
-                        if (buffer.isNull())
+                        QImage img = scaledImage(ss);
+                        if (img.isNull())
                               emptyImage = true;
                         else
-                              painter->drawPixmap(QPointF(0.0, 0.0), buffer);
+                              painter->drawImage(QPointF(0.0, 0.0), img);
                         }
                   painter->restore();
                   }
@@ -34,13 +34,14 @@ class Image final : public BSymbol {
 
       QSizeF pixel2size(const QSizeF& s) const;
       QSizeF size2pixel(const QSizeF& s) const;
+      QImage scaledImage(const QSize&) const;
 
    protected:
       ImageStoreItem* _storeItem;
       QString _storePath;           // the path of the img in the ImageStore
       QString _linkPath;            // the path of an external linked img
       bool _linkIsValid;            // whether _linkPath file exists or not
-      mutable QPixmap buffer;       ///< cached rendering
+      mutable QImage buffer;        ///< cached rendering, guarded by bufferMutex
       QSizeF _size;                 // in mm or spatium units
       bool _lockAspectRatio;
       bool _autoScale;              ///< fill parent frame
@@ -10,7 +10,10 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QCryptographicHash>
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
 #include "imageStore.h"
 #include "score.h"
 #include "image.h"
@@ -19,6 +22,14 @@ namespace Ms {
 
 ImageStore imageStore;  // the global image store
 
+//---------------------------------------------------------
+//   storeMutex
+//    the store is shared by all scores, which may also
+//    be loaded and deleted in worker threads
+//---------------------------------------------------------
+
+static QMutex storeMutex;
+
 //---------------------------------------------------------
 //   ImageStoreItem
 //---------------------------------------------------------
@@ -35,6 +46,7 @@ ImageStoreItem::ImageStoreItem(const QString& p)
 
 void ImageStoreItem::dereference(Image* image)
       {
+      QMutexLocker locker(&storeMutex);
       _references.removeOne(image);
       }
 
@@ -45,12 +57,14 @@ void ImageStoreItem::dereference(Image* image)
 
 void ImageStoreItem::reference(Image* image)
       {
+      QMutexLocker locker(&storeMutex);
       _references.append(image);
       }
 
 //---------------------------------------------------------
 //   isUsed
 //    check if item is used in score
+//    the store has to be locked
 //---------------------------------------------------------
 
 bool ImageStoreItem::isUsed(Score* score) const
@@ -154,6 +168,7 @@ ImageStore::~ImageStore()
 
 ImageStoreItem* ImageStore::getImage(const QString& path) const
       {
+      QMutexLocker locker(&storeMutex);
       QString s = QFileInfo(path).completeBaseName();
       if (s.size() != 32) {
             //
@@ -191,6 +206,7 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       QCryptographicHash h(QCryptographicHash::Md4);
       h.addData(ba);
       QByteArray hash = h.result();
+      QMutexLocker locker(&storeMutex);
       for (ImageStoreItem* item : _items) {
             if (item->hash() == hash)
                   return item;
@@ -201,12 +217,37 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
       return item;
       }
 
+//---------------------------------------------------------
+//   usedItems
+//    the items used by score
+//---------------------------------------------------------
+
+std::vector<ImageStoreItem*> ImageStore::usedItems(Score* score) const
+      {
+      QMutexLocker locker(&storeMutex);
+      std::vector<ImageStoreItem*> items;
+      for (ImageStoreItem* item : _items) {
+            if (item->isUsed(score))
+                  items.push_back(item);
+            }
+      return items;
+      }
+
 //---------------------------------------------------------
 //   clearUnused
+//    Items are added before the images of a score or
+//    palette reference them. Nothing is removed while a
+//    score is loading or outside the gui thread; unused
+//    items are removed the next time a score is deleted
+//    on the gui thread.
 //---------------------------------------------------------
 
 void ImageStore::clearUnused()
       {
+      QCoreApplication* app = QCoreApplication::instance();
+      if (ScoreLoad::loading() || (app && QThread::currentThread() != app->thread()))
+            return;
+      QMutexLocker locker(&storeMutex);
       _items.erase(
          std::remove_if(_items.begin(), _items.end(), [](ImageStoreItem* i) {
             const bool remove = !i->isUsed();
@@ -62,15 +62,8 @@ class ImageStore {
 
       ImageStoreItem* getImage(const QString& path) const;
       ImageStoreItem* add(const QString& path, const QByteArray&);
+      std::vector<ImageStoreItem*> usedItems(Score*) const;
       void clearUnused();
-
-      typedef ItemList::iterator iterator;
-      typedef ItemList::const_iterator const_iterator;
-
-      iterator begin() { return _items.begin(); }
-      const_iterator begin() const { return _items.begin(); }
-      iterator end() { return _items.end(); }
-      const_iterator end() const { return _items.end(); }
       };
 
 extern ImageStore imageStore;       // this is the global imageStore
@@ -1,26 +0,0 @@
-//=============================================================================
-//  MuseScore
-//  Music Composition & Notation
-//
-//  Copyright (C) 2002-2011 Werner Schweer
-//
-//  This program is free software; you can redistribute it and/or modify
-//  it under the terms of the GNU General Public License version 2
-//  as published by the Free Software Foundation and appearing in
-//  the file LICENCE.GPL
-//=============================================================================
-
-#ifndef __KEYFINDER_H__
-#define __KEYFINDER_H__
-
-namespace Ms {
-      class MidiTrack;
-      }
-
-namespace AL {
-      class TimeSigMap;
-      };
-
-
-#endif
-
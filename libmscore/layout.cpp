@@ -2072,6 +2072,7 @@ void Score::createMMRest(Measure* m, Measure* lm, const Fraction& len)
       MeasureBase* nm = _showVBox ? lm->next() : lm->nextMeasure();
       mmr->setNext(nm);
       mmr->setPrev(m->prev());
+      measures()->invalidateIndexMM();
       }
 
 //---------------------------------------------------------
@@ -3051,6 +3051,16 @@ QVariant Measure::propertyDefault(Pid propertyId) const
       return MeasureBase::propertyDefault(propertyId);
       }
 
+//---------------------------------------------------------
+//   setMMRest
+//---------------------------------------------------------
+
+void Measure::setMMRest(Measure* m)
+      {
+      _mmRest = m;
+      score()->measures()->invalidateIndexMM();
+      }
+
 //-------------------------------------------------------------------
 //   mmRestFirst
 //    this is a multi measure rest
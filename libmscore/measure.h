@@ -237,7 +237,7 @@ class Measure final : public MeasureBase {
       bool isMMRest() const         { return _mmRestCount > 0; }
       Measure* mmRest() const       { return _mmRest;      }
       const Measure* mmRest1() const;
-      void setMMRest(Measure* m)    { _mmRest = m;         }
+      void setMMRest(Measure* m);
       int mmRestCount() const       { return _mmRestCount; }    // number of measures _mmRest spans
       void setMMRestCount(int n)    { _mmRestCount = n;    }
       Measure* mmRestFirst() const;
@@ -363,7 +363,7 @@ class MScore {
       static qreal nudgeStep10;
       static qreal nudgeStep50;
       static int defaultPlayDuration;
-      static QString lastError;
+      static thread_local QString lastError;    // per thread, scores may be read in a worker thread
 
 // #ifndef NDEBUG
       static bool noHorizontalStretch;
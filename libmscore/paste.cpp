@@ -113,7 +113,10 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                 staves        = e.intAttribute("staves", 0);
 
             Fraction oEndTick = dstTick + oTickLen;
-            auto oSpanner = spannerMap().findContained(dstTick.ticks(), oEndTick.ticks());
+            // build list of original spanners
+            std::vector<Spanner*> oSpannerList;
+            for (auto interval : spannerMap().findContained(dstTick.ticks(), oEndTick.ticks()))
+                  oSpannerList.push_back(interval.value);
             bool spannerFound = false;
 
             e.setTickOffset(dstTick - tickStart);
@@ -182,23 +185,8 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                               tuplet = new Tuplet(this);
                               tuplet->setTrack(e.track());
                               tuplet->read(e);
-                              if (doScale) {
-                                    tuplet->setTicks(tuplet->ticks() * scale);
-                                    tuplet->setBaseLen(tuplet->baseLen().fraction() * scale);
-                                    }
-                              Measure* measure = tick2measure(tick);
-                              tuplet->setParent(measure);
-                              tuplet->setTick(tick);
-                              tuplet->setTuplet(oldTuplet);
-                              if (tuplet->rtick() + tuplet->actualTicks() > measure->ticks()) {
-                                    delete tuplet;
-                                    if (oldTuplet && oldTuplet->elements().empty())
-                                          delete oldTuplet;
-                                    MScore::setError(TUPLET_CROSSES_BAR);
+                              if (!pasteTuplet(tuplet, oldTuplet, tick, scale))
                                     return false;
-                                    }
-                              if (oldTuplet)
-                                    tuplet->readAddTuplet(oldTuplet);
                               }
                         else if (tag == "endTuplet") {
                               if (!tuplet) {
@@ -206,16 +194,7 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                                     e.skipCurrentElement();
                                     continue;
                                     }
-                              Tuplet* oldTuplet = tuplet;
-                              tuplet = tuplet->tuplet();
-                              if (oldTuplet->elements().empty()) {
-                                    qDebug("Score::pasteStaff: ended tuplet is empty");
-                                    if (tuplet)
-                                          tuplet->remove(oldTuplet);
-                                    delete oldTuplet;
-                                    }
-                              else
-                                    oldTuplet->sortElements();
+                              tuplet = pasteTupletEnd(tuplet);
                               e.readNext();
                               }
                         else if (tag == "Chord" || tag == "Rest" || tag == "RepeatMeasure") {
@@ -239,84 +218,8 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                                     if (tuplet)
                                           cr->readAddTuplet(tuplet);
                                     e.incTick(cr->actualTicks());
-                                    if (doScale) {
-                                          Fraction d = cr->durationTypeTicks();
-                                          cr->setTicks(cr->ticks() * scale);
-                                          cr->setDurationType(d * scale);
-                                          for (Lyrics* l : cr->lyrics())
-                                                l->setTicks(l->ticks() * scale);
-                                          }
-                                    if (cr->isChord()) {
-                                          Chord* chord = toChord(cr);
-                                          // disallow tie across barline within two-note tremolo
-                                          // tremolos can potentially still straddle the barline if no tie is required
-                                          // but these will be removed later
-                                          Tremolo* t = chord->tremolo();
-                                          if (t && t->twoNotes()) {
-                                                if (doScale) {
-                                                      Fraction d = t->durationType().ticks();
-                                                      t->setDurationType(d * scale);
-                                                      }
-                                                Measure* m = tick2measure(tick);
-                                                Fraction ticks = cr->actualTicks();
-                                                Fraction rticks = m->endTick() - tick;
-                                                if (rticks < ticks || (rticks != ticks && rticks < ticks * 2)) {
-                                                      MScore::setError(DEST_TREMOLO);
-                                                      return false;
-                                                      }
-                                                }
-                                          for (int i = 0; i < graceNotes.size(); ++i) {
-                                                Chord* gc = graceNotes[i];
-                                                gc->setGraceIndex(i);
-                                                transposeChord(gc, e.transpose(), tick);
-                                                chord->add(gc);
-                                                }
-                                          graceNotes.clear();
-                                          }
-                                    // delete pending ties, they are not selected when copy
-                                    if ((tick - dstTick) + cr->actualTicks() >= tickLen) {
-                                          if (cr->isChord()) {
-                                                Chord* c = toChord(cr);
-                                                for (Note* note: c->notes()) {
-                                                      Tie* tie = note->tieFor();
-                                                      if (tie) {
-                                                            note->setTieFor(0);
-                                                            delete tie;
-                                                            }
-                                                      }
-                                                }
-                                          }
-                                    // shorten last cr to fit in the space made by makeGap
-                                    if ((tick - dstTick) + cr->actualTicks() > tickLen) {
-                                          Fraction newLength = tickLen - (tick - dstTick);
-                                          // check previous CR on same track, if it has tremolo, delete the tremolo
-                                          // we don't want a tremolo and two different chord durations
-                                          if (cr->isChord()) {
-                                                Segment* s = tick2leftSegment(tick - Fraction::fromTicks(1));
-                                                if (s) {
-                                                      ChordRest* crt = toChordRest(s->element(cr->track()));
-                                                      if (!crt)
-                                                            crt = s->nextChordRest(cr->track(), true);
-                                                      if (crt && crt->isChord()) {
-                                                            Chord* chrt = toChord(crt);
-                                                            Tremolo* tr = chrt->tremolo();
-                                                            if (tr) {
-                                                                  tr->setChords(chrt, toChord(cr));
-                                                                  chrt->remove(tr);
-                                                                  delete tr;
-                                                                  }
-                                                            }
-                                                      }
-                                                }
-                                          if (!cr->tuplet()) {
-                                                // shorten duration
-                                                // exempt notes in tuplets, since we don't allow copy of partial tuplet anyhow
-                                                // TODO: figure out a reasonable fudge factor to make sure shorten tuplets appropriately if we do ever copy a partial tuplet
-                                                cr->setTicks(newLength);
-                                                cr->setDurationType(newLength);
-                                                }
-                                          }
-                                    pasteChordRest(cr, tick, e.transpose());
+                                    if (!pasteStaffChordRest(cr, graceNotes, tick, dstTick, tickLen, scale, e.transpose()))
+                                          return false;
                                     }
                               }
                         else if (tag == "Spanner") {
@@ -327,24 +230,8 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                               Harmony* harmony = new Harmony(this);
                               harmony->setTrack(e.track());
                               harmony->read(e);
-                              harmony->setTrack(e.track());
-                              // transpose
                               Fraction tick = doScale ? (e.tick() - dstTick) * scale + dstTick : e.tick();
-                              Part* partDest = staff(e.track() / VOICES)->part();
-                              Interval interval = partDest->instrument(tick)->transpose();
-                              if (!styleB(Sid::concertPitch) && !interval.isZero()) {
-                                    interval.flip();
-                                    int rootTpc = transposeTpc(harmony->rootTpc(), interval, true);
-                                    int baseTpc = transposeTpc(harmony->baseTpc(), interval, true);
-                                    undoTransposeHarmony(harmony, rootTpc, baseTpc);
-                                    }
-
-                              Measure* m = tick2measure(tick);
-                              Segment* seg = m->undoGetSegment(SegmentType::ChordRest, tick);
-                              for (Element* el : seg->findAnnotations(ElementType::HARMONY, e.track(), e.track()))
-                                    undoRemoveElement(el);
-                              harmony->setParent(seg);
-                              undoAddElement(harmony);
+                              pasteAnnotation(harmony, tick, e.track());
                               }
                         else if (tag == "Dynamic"
                            || tag == "Symbol"
@@ -364,40 +251,22 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                               if (el->isFermata())
                                     el->setPlacement(el->track() & 1 ? Placement::BELOW : Placement::ABOVE);
                               el->read(e);
-
                               Fraction tick = doScale ? (e.tick() - dstTick) * scale + dstTick : e.tick();
-                              Measure* m = tick2measure(tick);
-                              Segment* seg = m->undoGetSegment(SegmentType::ChordRest, tick);
-                              el->setParent(seg);
-
-                              // be sure to paste the element in the destination track;
-                              // setting track needs to be repeated, as it might have been overwritten by el->read()
-                              // preserve *voice* from source, though
-                              el->setTrack((e.track() / VOICES) * VOICES + el->voice());
-
-                              undoAddElement(el);
+                              pasteAnnotation(el, tick, e.track());
                               }
                         else if (tag == "Clef") {
                               Clef* clef = new Clef(this);
                               clef->read(e);
                               clef->setTrack(e.track());
                               Fraction tick = doScale ? (e.tick() - dstTick) * scale + dstTick : e.tick();
-                              Measure* m = tick2measure(tick);
-                              if (m->tick().isNotZero() && m->tick() == tick)
-                                    m = m->prevMeasure();
-                              Segment* segment = m->undoGetSegment(SegmentType::Clef, tick);
-                              clef->setParent(segment);
-                              undoChangeElement(segment->element(e.track()), clef);
+                              pasteClef(clef, tick);
                               }
                         else if (tag == "Breath") {
                               Breath* breath = new Breath(this);
                               breath->read(e);
                               breath->setTrack(e.track());
                               Fraction tick = doScale ? (e.tick() - dstTick) * scale + dstTick : e.tick();
-                              Measure* m = tick2measure(tick);
-                              Segment* segment = m->undoGetSegment(SegmentType::Breath, tick);
-                              breath->setParent(segment);
-                              undoChangeElement(segment->element(e.track()), breath);
+                              pasteBreath(breath, tick);
                               }
                         else if (tag == "Beam") {
                               Beam* beam = new Beam(this);
@@ -434,77 +303,458 @@ bool Score::pasteStaff(XmlReader& e, Segment* dst, int dstStaff, Fraction scale)
                         }
                   }
             // fix up spanners
-            if (doScale && spannerFound) {
-                  // build list of original spanners
-                  std::vector<Spanner*> oSpannerList;
-                  for (auto interval : oSpanner) {
-                        Spanner* sp = interval.value;
-                        oSpannerList.push_back(sp);
+            if (doScale && spannerFound)
+                  rescalePastedSpanners(oSpannerList, dstTick, oEndTick, dstStaff, staves, scale);
+            }
+
+      for (Score* s : scoreList())     // for all parts
+            s->connectTies();
+
+      if (pasted)                         //select only if we pasted something
+            selectPastedRange(dstTick, tickLen, dstStaff, staves);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   pasteStaff
+//    paste a range copied in this process: the elements
+//    cloned at copy time are cloned again instead of being
+//    read back from the xml form
+//    return false if paste fails
+//---------------------------------------------------------
+
+bool Score::pasteStaff(StaffListClone& clip, Segment* dst, int dstStaff, Fraction scale)
+      {
+      Q_ASSERT(dst->isChordRestType());
+
+      Fraction dstTick  = dst->tick();
+      Fraction tickLen  = clip.ticks * scale;
+      Fraction oEndTick = dstTick + clip.ticks;
+      int staves        = int(clip.staves.size());
+      int trackOffset   = (dstStaff - clip.staffStart) * VOICES;
+      bool doScale      = (scale != Fraction(1, 1));
+      bool pasted       = false;
+
+      // build list of original spanners
+      std::vector<Spanner*> oSpannerList;
+      for (auto interval : spannerMap().findContained(dstTick.ticks(), oEndTick.ticks()))
+            oSpannerList.push_back(interval.value);
+
+      clip.setScore(this);
+      QHash<const Element*, Element*> pastedElements;    // cloned chord/rests and notes to the pasted ones
+
+      for (StaffListClone::StaffClip& sc : clip.staves) {
+            int dstStaffIdx = sc.srcStaffIdx + trackOffset / VOICES;
+            if (dstStaffIdx >= nstaves()) {
+                  qDebug("paste beyond staves");
+                  break;
+                  }
+            pasted = true;
+            int voiceOffset[VOICES];
+            std::copy(sc.voiceOffset, sc.voiceOffset + VOICES, voiceOffset);
+            if (!makeGap1(dstTick, dstStaffIdx, tickLen, voiceOffset)) {
+                  qDebug("cannot make gap in staff %d at tick %d", dstStaffIdx, dstTick.ticks());
+                  break;
+                  }
+
+            Tuplet* tuplet = nullptr;
+            for (const StaffListClone::Item& item : sc.items) {
+                  if (item.type == StaffListClone::ItemType::END_TUPLET) {
+                        if (tuplet)
+                              tuplet = pasteTupletEnd(tuplet);
+                        continue;
+                        }
+                  Fraction tick = (item.tick - clip.tickStart) * scale + dstTick;
+                  int track     = item.track + trackOffset;
+                  // the clone must see its destination staff when it is cloned
+                  item.e->setTrack(track);
+                  switch (item.type) {
+                        case StaffListClone::ItemType::TUPLET:
+                              {
+                              // no paste into local time signature
+                              if (staff(dstStaffIdx)->isLocalTimeSignature(tick)) {
+                                    MScore::setError(DEST_LOCAL_TIME_SIGNATURE);
+                                    if (tuplet && tuplet->elements().empty())
+                                          delete tuplet;
+                                    return false;
+                                    }
+                              Tuplet* t = toTuplet(item.e->clone());
+                              if (!pasteTuplet(t, tuplet, tick, scale))
+                                    return false;
+                              tuplet = t;
+                              }
+                              break;
+                        case StaffListClone::ItemType::CHORDREST:
+                              {
+                              // no paste into local time signature
+                              if (staff(dstStaffIdx)->isLocalTimeSignature(tick)) {
+                                    MScore::setError(DEST_LOCAL_TIME_SIGNATURE);
+                                    return false;
+                                    }
+                              ChordRest* cr = toChordRest(item.e->clone());
+                              if (tuplet)
+                                    cr->readAddTuplet(tuplet);
+                              if (cr->isChord()) {
+                                    // grace notes come with their chord
+                                    for (Chord* gc : toChord(cr)->graceNotes())
+                                          transposeChord(gc, sc.transpose, tick);
+                                    StaffListClone::mapChord(toChord(item.e), toChord(cr), pastedElements);
+                                    }
+                              else if (cr->isRest())
+                                    pastedElements.insert(item.e, cr);
+                              QList<Chord*> graceNotes;
+                              if (!pasteStaffChordRest(cr, graceNotes, tick, dstTick, tickLen, scale, sc.transpose))
+                                    return false;
+                              }
+                              break;
+                        case StaffListClone::ItemType::ANNOTATION:
+                              pasteAnnotation(item.e->clone(), tick, track);
+                              break;
+                        case StaffListClone::ItemType::CLEF:
+                              pasteClef(toClef(item.e->clone()), tick);
+                              break;
+                        case StaffListClone::ItemType::BREATH:
+                              pasteBreath(toBreath(item.e->clone()), tick);
+                              break;
+                        case StaffListClone::ItemType::END_TUPLET:
+                              break;
                         }
-                  auto nSpanner = spannerMap().findContained(dstTick.ticks(), oEndTick.ticks());
-                  for (auto interval : nSpanner) {
-                        Spanner* sp = interval.value;
-                        // skip if not in this staff list
-                        if (sp->staffIdx() < dstStaff || sp->staffIdx() >= dstStaff + staves)
-                              continue;
-                        // CHORD and NOTE spanners are normally handled already
-                        if (sp->anchor() == Spanner::Anchor::CHORD || sp->anchor() == Spanner::Anchor::NOTE)
-                              continue;
-                        // skip if present oiginally
-                        auto i = std::find(oSpannerList.begin(), oSpannerList.end(), sp);
-                        if (i != oSpannerList.end())
-                              continue;
-                        Fraction tick = (sp->tick() - dstTick) * scale + dstTick;
-                        sp->undoChangeProperty(Pid::SPANNER_TICK, tick);
-                        sp->undoChangeProperty(Pid::SPANNER_TICKS, sp->ticks() * scale);
+                  }
+            if (tuplet) {
+                  qDebug("tuplet not ended");
+                  if (tuplet->elements().empty()) {
+                        if (tuplet->tuplet())
+                              tuplet->tuplet()->remove(tuplet);
+                        delete tuplet;
                         }
                   }
             }
 
+      for (const StaffListClone::TieClip& tc : clip.ties) {
+            Note* startNote = toNote(pastedElements.value(tc.startNote));
+            Note* endNote   = toNote(pastedElements.value(tc.endNote));
+            if (!startNote || !endNote)
+                  continue;
+            // a chord split at a barline is tied through already
+            while (startNote->tieFor() && startNote->tieFor()->endNote())
+                  startNote = startNote->tieFor()->endNote();
+            Tie* tie = toTie(tc.tie->clone());
+            tie->setParent(startNote);
+            tie->setStartNote(startNote);
+            tie->setEndNote(endNote);
+            tie->setTrack(startNote->track());
+            undoAddElement(tie);
+            }
+      for (const StaffListClone::SlurClip& sc : clip.slurs) {
+            ChordRest* startCR = toChordRest(pastedElements.value(sc.startCR));
+            ChordRest* endCR   = toChordRest(pastedElements.value(sc.endCR));
+            if (!startCR || !endCR)
+                  continue;
+            Slur* slur = toSlur(sc.slur->clone());
+            slur->setTick(startCR->tick());
+            slur->setTrack(startCR->track());
+            slur->setTick2(endCR->tick());
+            slur->setTrack2(endCR->track());
+            slur->setStartElement(startCR);
+            slur->setEndElement(endCR);
+            undoAddElement(slur);
+            }
+      for (Spanner* csp : clip.spanners) {
+            int track = csp->track() + trackOffset;
+            if (track < 0 || track >= ntracks())
+                  continue;
+            Spanner* sp = toSpanner(csp->clone());
+            sp->setAnchor(Spanner::Anchor::SEGMENT);
+            sp->setTrack(track);
+            sp->setTrack2(track);
+            sp->setTick(csp->tick() - clip.tickStart + dstTick);
+            sp->setTick2(csp->tick2() - clip.tickStart + dstTick);
+            undoAddElement(sp);
+            if (sp->isOttava())
+                  sp->staff()->updateOttava();
+            }
+      // fix up spanners
+      if (doScale && !clip.spanners.empty())
+            rescalePastedSpanners(oSpannerList, dstTick, oEndTick, dstStaff, staves, scale);
+
       for (Score* s : scoreList())     // for all parts
             s->connectTies();
 
-      if (pasted) {                       //select only if we pasted something
-            int endStaff = dstStaff + staves;
-            if (endStaff > nstaves())
-                  endStaff = nstaves();
-            //check and add truly invisible rests insted of gaps
-            //TODO: look if this could be done different
-            Measure* dstM = tick2measure(dstTick);
-            Measure* endM = tick2measure(dstTick + tickLen);
-            for (int i = dstStaff; i < endStaff; i++) {
-                  for (Measure* m = dstM; m && m != endM->nextMeasure(); m = m->nextMeasure())
-                        m->checkMeasure(i);
+      if (pasted)                         //select only if we pasted something
+            selectPastedRange(dstTick, tickLen, dstStaff, staves);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   pasteStaffChordRest
+//    scale a pasted chord/rest, attach the grace notes read
+//    before it and fit it into the gap made by makeGap1()
+//    return false if paste fails
+//---------------------------------------------------------
+
+bool Score::pasteStaffChordRest(ChordRest* cr, QList<Chord*>& graceNotes, const Fraction& tick, const Fraction& dstTick,
+   const Fraction& tickLen, const Fraction& scale, const Interval& srcTranspose)
+      {
+      bool doScale = (scale != Fraction(1, 1));
+      if (doScale) {
+            Fraction d = cr->durationTypeTicks();
+            cr->setTicks(cr->ticks() * scale);
+            cr->setDurationType(d * scale);
+            for (Lyrics* l : cr->lyrics())
+                  l->setTicks(l->ticks() * scale);
+            }
+      if (cr->isChord()) {
+            Chord* chord = toChord(cr);
+            // disallow tie across barline within two-note tremolo
+            // tremolos can potentially still straddle the barline if no tie is required
+            // but these will be removed later
+            Tremolo* t = chord->tremolo();
+            if (t && t->twoNotes()) {
+                  if (doScale) {
+                        Fraction d = t->durationType().ticks();
+                        t->setDurationType(d * scale);
+                        }
+                  Measure* m = tick2measure(tick);
+                  Fraction ticks = cr->actualTicks();
+                  Fraction rticks = m->endTick() - tick;
+                  if (rticks < ticks || (rticks != ticks && rticks < ticks * 2)) {
+                        MScore::setError(DEST_TREMOLO);
+                        return false;
+                        }
                   }
-            _selection.setRangeTicks(dstTick, dstTick + tickLen, dstStaff, endStaff);
-
-            //finding the first element that has a track
-            //the canvas position will be set to this element
-            Element* el = 0;
-            Segment* s = tick2segmentMM(dstTick);
-            Segment* s2 = tick2segmentMM(dstTick + tickLen);
-            bool found = false;
-            if (s2)
-                  s2 = s2->next1MM();
-            while (!found && s != s2) {
-                  for (int i = dstStaff * VOICES; i < (endStaff + 1) * VOICES; i++) {
-                        el = s->element(i);
-                        if (el) {
-                              found = true;
-                              break;
+            for (int i = 0; i < graceNotes.size(); ++i) {
+                  Chord* gc = graceNotes[i];
+                  gc->setGraceIndex(i);
+                  transposeChord(gc, srcTranspose, tick);
+                  chord->add(gc);
+                  }
+            graceNotes.clear();
+            }
+      // delete pending ties, they are not selected when copy
+      if ((tick - dstTick) + cr->actualTicks() >= tickLen) {
+            if (cr->isChord()) {
+                  Chord* c = toChord(cr);
+                  for (Note* note: c->notes()) {
+                        Tie* tie = note->tieFor();
+                        if (tie) {
+                              note->setTieFor(0);
+                              delete tie;
                               }
                         }
-                  s = s->next1MM();
                   }
+            }
+      // shorten last cr to fit in the space made by makeGap
+      if ((tick - dstTick) + cr->actualTicks() > tickLen) {
+            Fraction newLength = tickLen - (tick - dstTick);
+            // check previous CR on same track, if it has tremolo, delete the tremolo
+            // we don't want a tremolo and two different chord durations
+            if (cr->isChord()) {
+                  Segment* s = tick2leftSegment(tick - Fraction::fromTicks(1));
+                  if (s) {
+                        ChordRest* crt = toChordRest(s->element(cr->track()));
+                        if (!crt)
+                              crt = s->nextChordRest(cr->track(), true);
+                        if (crt && crt->isChord()) {
+                              Chord* chrt = toChord(crt);
+                              Tremolo* tr = chrt->tremolo();
+                              if (tr) {
+                                    tr->setChords(chrt, toChord(cr));
+                                    chrt->remove(tr);
+                                    delete tr;
+                                    }
+                              }
+                        }
+                  }
+            if (!cr->tuplet()) {
+                  // shorten duration
+                  // exempt notes in tuplets, since we don't allow copy of partial tuplet anyhow
+                  // TODO: figure out a reasonable fudge factor to make sure shorten tuplets appropriately if we do ever copy a partial tuplet
+                  cr->setTicks(newLength);
+                  cr->setDurationType(newLength);
+                  }
+            }
+      pasteChordRest(cr, tick, srcTranspose);
+      return true;
+      }
 
-            for (MuseScoreView* v : viewer)
-                  v->adjustCanvasPosition(el, false);
-            if (!selection().isRange())
-                  _selection.setState(SelState::RANGE);
+//---------------------------------------------------------
+//   pasteTuplet
+//    place a pasted tuplet at tick, inside of parent
+//    return false if it crosses a barline
+//---------------------------------------------------------
+
+bool Score::pasteTuplet(Tuplet* tuplet, Tuplet* parent, const Fraction& tick, const Fraction& scale)
+      {
+      if (scale != Fraction(1, 1)) {
+            tuplet->setTicks(tuplet->ticks() * scale);
+            tuplet->setBaseLen(tuplet->baseLen().fraction() * scale);
+            }
+      Measure* measure = tick2measure(tick);
+      tuplet->setParent(measure);
+      tuplet->setTick(tick);
+      tuplet->setTuplet(parent);
+      if (tuplet->rtick() + tuplet->actualTicks() > measure->ticks()) {
+            delete tuplet;
+            if (parent && parent->elements().empty())
+                  delete parent;
+            MScore::setError(TUPLET_CROSSES_BAR);
+            return false;
             }
+      if (parent)
+            tuplet->readAddTuplet(parent);
       return true;
       }
 
+//---------------------------------------------------------
+//   pasteTupletEnd
+//    return the tuplet enclosing the ended one
+//---------------------------------------------------------
+
+Tuplet* Score::pasteTupletEnd(Tuplet* tuplet)
+      {
+      Tuplet* parent = tuplet->tuplet();
+      if (tuplet->elements().empty()) {
+            qDebug("Score::pasteStaff: ended tuplet is empty");
+            if (parent)
+                  parent->remove(tuplet);
+            delete tuplet;
+            }
+      else
+            tuplet->sortElements();
+      return parent;
+      }
+
+//---------------------------------------------------------
+//   pasteAnnotation
+//---------------------------------------------------------
+
+void Score::pasteAnnotation(Element* el, const Fraction& tick, int track)
+      {
+      Measure* m = tick2measure(tick);
+      Segment* seg = m->undoGetSegment(SegmentType::ChordRest, tick);
+      if (el->isHarmony()) {
+            Harmony* harmony = toHarmony(el);
+            harmony->setTrack(track);
+            // transpose
+            Part* partDest = staff(track / VOICES)->part();
+            Interval interval = partDest->instrument(tick)->transpose();
+            if (!styleB(Sid::concertPitch) && !interval.isZero()) {
+                  interval.flip();
+                  int rootTpc = transposeTpc(harmony->rootTpc(), interval, true);
+                  int baseTpc = transposeTpc(harmony->baseTpc(), interval, true);
+                  undoTransposeHarmony(harmony, rootTpc, baseTpc);
+                  }
+            for (Element* e : seg->findAnnotations(ElementType::HARMONY, track, track))
+                  undoRemoveElement(e);
+            }
+      else {
+            // be sure to paste the element in the destination track;
+            // setting track needs to be repeated, as it might have been overwritten by el->read()
+            // preserve *voice* from source, though
+            el->setTrack((track / VOICES) * VOICES + el->voice());
+            }
+      el->setParent(seg);
+      undoAddElement(el);
+      }
+
+//---------------------------------------------------------
+//   pasteClef
+//---------------------------------------------------------
+
+void Score::pasteClef(Clef* clef, const Fraction& tick)
+      {
+      Measure* m = tick2measure(tick);
+      if (m->tick().isNotZero() && m->tick() == tick)
+            m = m->prevMeasure();
+      Segment* segment = m->undoGetSegment(SegmentType::Clef, tick);
+      clef->setParent(segment);
+      undoChangeElement(segment->element(clef->track()), clef);
+      }
+
+//---------------------------------------------------------
+//   pasteBreath
+//---------------------------------------------------------
+
+void Score::pasteBreath(Breath* breath, const Fraction& tick)
+      {
+      Measure* m = tick2measure(tick);
+      Segment* segment = m->undoGetSegment(SegmentType::Breath, tick);
+      breath->setParent(segment);
+      undoChangeElement(segment->element(breath->track()), breath);
+      }
+
+//---------------------------------------------------------
+//   rescalePastedSpanners
+//    scale the segment anchored spanners a scaled paste
+//    added, oSpannerList are those which were there before
+//---------------------------------------------------------
+
+void Score::rescalePastedSpanners(const std::vector<Spanner*>& oSpannerList, const Fraction& dstTick, const Fraction& oEndTick,
+   int dstStaff, int staves, const Fraction& scale)
+      {
+      auto nSpanner = spannerMap().findContained(dstTick.ticks(), oEndTick.ticks());
+      for (auto interval : nSpanner) {
+            Spanner* sp = interval.value;
+            // skip if not in this staff list
+            if (sp->staffIdx() < dstStaff || sp->staffIdx() >= dstStaff + staves)
+                  continue;
+            // CHORD and NOTE spanners are normally handled already
+            if (sp->anchor() == Spanner::Anchor::CHORD || sp->anchor() == Spanner::Anchor::NOTE)
+                  continue;
+            // skip if present oiginally
+            auto i = std::find(oSpannerList.begin(), oSpannerList.end(), sp);
+            if (i != oSpannerList.end())
+                  continue;
+            Fraction tick = (sp->tick() - dstTick) * scale + dstTick;
+            sp->undoChangeProperty(Pid::SPANNER_TICK, tick);
+            sp->undoChangeProperty(Pid::SPANNER_TICKS, sp->ticks() * scale);
+            }
+      }
+
+//---------------------------------------------------------
+//   selectPastedRange
+//---------------------------------------------------------
+
+void Score::selectPastedRange(const Fraction& dstTick, const Fraction& tickLen, int dstStaff, int staves)
+      {
+      int endStaff = dstStaff + staves;
+      if (endStaff > nstaves())
+            endStaff = nstaves();
+      //check and add truly invisible rests insted of gaps
+      //TODO: look if this could be done different
+      Measure* dstM = tick2measure(dstTick);
+      Measure* endM = tick2measure(dstTick + tickLen);
+      for (int i = dstStaff; i < endStaff; i++) {
+            for (Measure* m = dstM; m && m != endM->nextMeasure(); m = m->nextMeasure())
+                  m->checkMeasure(i);
+            }
+      _selection.setRangeTicks(dstTick, dstTick + tickLen, dstStaff, endStaff);
+
+      //finding the first element that has a track
+      //the canvas position will be set to this element
+      Element* el = 0;
+      Segment* s = tick2segmentMM(dstTick);
+      Segment* s2 = tick2segmentMM(dstTick + tickLen);
+      bool found = false;
+      if (s2)
+            s2 = s2->next1MM();
+      while (!found && s != s2) {
+            for (int i = dstStaff * VOICES; i < (endStaff + 1) * VOICES; i++) {
+                  el = s->element(i);
+                  if (el) {
+                        found = true;
+                        break;
+                        }
+                  }
+            s = s->next1MM();
+            }
+
+      for (MuseScoreView* v : viewer)
+            v->adjustCanvasPosition(el, false);
+      if (!selection().isRange())
+            _selection.setState(SelState::RANGE);
+      }
+
 //---------------------------------------------------------
 //   Score::readAddConnector
 //---------------------------------------------------------
@@ -1024,13 +1274,21 @@ void Score::cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale)
                   return;
                   }
             else {
-                  QByteArray data(ms->data(mimeStaffListFormat));
-                  if (MScore::debugMode)
-                        qDebug("paste <%s>", data.data());
-                  XmlReader e(data);
-                  e.setPasteMode(true);
-                  if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale))
-                        return;
+                  // copied in this process: paste the clones, not the xml
+                  const StaffListMimeData* sd = qobject_cast<const StaffListMimeData*>(ms);
+                  if (sd && sd->staffList()) {
+                        if (!pasteStaff(*sd->staffList(), cr->segment(), cr->staffIdx(), scale))
+                              return;
+                        }
+                  else {
+                        QByteArray data(ms->data(mimeStaffListFormat));
+                        if (MScore::debugMode)
+                              qDebug("paste <%s>", data.data());
+                        XmlReader e(data);
+                        e.setPasteMode(true);
+                        if (!pasteStaff(e, cr->segment(), cr->staffIdx(), scale))
+                              return;
+                        }
                   }
             }
       else if (ms->hasFormat(mimeSymbolListFormat)) {
@@ -15,6 +15,7 @@
  render score into event list
 */
 
+#include <limits>
 #include <set>
 
 #include "rendermidi.h"
@@ -2640,6 +2641,67 @@ void MidiRenderer::updateChunksPartition()
             if (chunkStart) // last measures did not get added to chunk list
                   chunks.emplace_back(tickOffset, chunkStart, rs->lastMeasure());
             }
+
+      chunkRanges.clear();
+      chunkRanges.reserve(chunks.size());
+      for (const Chunk& ch : chunks)
+            chunkRanges.push_back({ ch.utick1(), ch.utick2(), ch.tickOffset() });
+      }
+
+//---------------------------------------------------------
+//   MidiRenderer::setScoreChanged
+///   Update the chunks partition after a score change in
+///   tick range [tick1, tick2] and return the utick ranges
+///   which need to be rendered again. These are all chunks
+///   overlapping the changed range together with their
+///   neighbours, to account for ties and repeat measures,
+///   and all chunks which differ from the previous partition.
+//---------------------------------------------------------
+
+std::vector<std::pair<int, int>> MidiRenderer::setScoreChanged(int tick1, int tick2)
+      {
+      std::vector<std::pair<int, int>> ranges;
+      if (needUpdate) {
+            // no partition to compare to
+            ranges.emplace_back(0, std::numeric_limits<int>::max());
+            return ranges;
+            }
+
+      const std::vector<ChunkRange> oldRanges = chunkRanges;
+      needUpdate = true;
+      updateState();
+
+      auto unchanged = [](const std::vector<ChunkRange>& v, const ChunkRange& r) {
+            auto it = std::lower_bound(v.begin(), v.end(), r, [](const ChunkRange& a, const ChunkRange& b) { return a.utick1 < b.utick1; });
+            return it != v.end() && *it == r;
+            };
+
+      const int n = int(chunks.size());
+      std::vector<bool> dirty(n, false);
+      for (int i = 0; i < n; ++i) {
+            const Chunk& ch = chunks[i];
+            if (ch.tick1() <= tick2 && tick1 < ch.tick2()) {
+                  for (int k = qMax(i - 1, 0); k <= qMin(i + 1, n - 1); ++k)
+                        dirty[k] = true;
+                  }
+            else if (!unchanged(oldRanges, chunkRanges[i]))
+                  dirty[i] = true;
+            }
+      for (int i = 0; i < n; ++i) {
+            if (!dirty[i])
+                  continue;
+            const ChunkRange& r = chunkRanges[i];
+            if (!ranges.empty() && ranges.back().second == r.utick1)
+                  ranges.back().second = r.utick2;
+            else
+                  ranges.emplace_back(r.utick1, r.utick2);
+            }
+      // events of chunks which are gone have to be removed too
+      for (const ChunkRange& r : oldRanges) {
+            if (!unchanged(chunkRanges, r))
+                  ranges.emplace_back(r.utick1, r.utick2);
+            }
+      return ranges;
       }
 
 //---------------------------------------------------------
@@ -2685,6 +2747,26 @@ void RangeMap::setOccupied(int tick1, int tick2)
             }
       }
 
+//---------------------------------------------------------
+//   RangeMap::setUnoccupied
+//---------------------------------------------------------
+
+void RangeMap::setUnoccupied(int tick1, int tick2)
+      {
+      if (tick1 >= tick2)
+            return;
+      auto it = status.lower_bound(tick1);
+      const bool occupiedBefore = (it != status.begin()) && std::prev(it)->second == Range::BEGIN;
+      const auto it2 = status.upper_bound(tick2);
+      const bool occupiedAfter = (it2 != status.begin()) && std::prev(it2)->second == Range::BEGIN;
+
+      status.erase(it, it2);
+      if (occupiedBefore)
+            status.insert(std::make_pair(tick1, Range::END));
+      if (occupiedAfter)
+            status.insert(std::make_pair(tick2, Range::BEGIN));
+      }
+
 //---------------------------------------------------------
 //   RangeMap::occupiedRangeEnd
 //---------------------------------------------------------
@@ -49,6 +49,7 @@ class RangeMap {
    public:
       void setOccupied(int tick1, int tick2);
       void setOccupied(std::pair<int, int> range) { setOccupied(range.first, range.second); }
+      void setUnoccupied(int tick1, int tick2);
 
       int occupiedRangeEnd(int tick) const;
 
@@ -89,7 +90,15 @@ class MidiRenderer {
             };
 
    private:
+      struct ChunkRange {
+            int utick1;
+            int utick2;
+            int tickOffset;
+            bool operator==(const ChunkRange& r) const { return utick1 == r.utick1 && utick2 == r.utick2 && tickOffset == r.tickOffset; }
+            };
+
       std::vector<Chunk> chunks;
+      std::vector<ChunkRange> chunkRanges;      // chunks partition as of last update, survives score changes
 
       void updateChunksPartition();
       static bool canBreakChunk(const Measure* last);
@@ -107,6 +116,7 @@ class MidiRenderer {
       void renderChunk(const Chunk&, EventMap* events, const SynthesizerState& synthState, bool metronome = true);
 
       void setScoreChanged() { needUpdate = true; }
+      std::vector<std::pair<int, int>> setScoreChanged(int tick1, int tick2);
       void setMinChunkSize(int sizeMeasures) { minChunkSize = sizeMeasures; needUpdate = true; }
 
       Chunk getChunkAt(int utick);
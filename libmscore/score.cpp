@@ -76,6 +76,7 @@ namespace Ms {
 
 MasterScore* gscore;                 ///< system score, used for palettes etc.
 std::set<Score*> Score::validScores;
+QMutex Score::validScoresMutex;
 
 bool scriptDebug     = false;
 bool noSeq           = false;
@@ -113,6 +114,10 @@ void MeasureBaseList::push_back(MeasureBase* e)
             e->setNext(0);
             }
       _last = e;
+      // appending keeps the tick order, no need to rebuild the index
+      if (_indexValid && e->isMeasure())
+            _index.push_back(toMeasure(e));
+      _indexMMValid = false;
       }
 
 //---------------------------------------------------------
@@ -133,6 +138,7 @@ void MeasureBaseList::push_front(MeasureBase* e)
             e->setNext(0);
             }
       _first = e;
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -155,6 +161,7 @@ void MeasureBaseList::add(MeasureBase* e)
       e->setPrev(el->prev());
       el->prev()->setNext(e);
       el->setPrev(e);
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -172,6 +179,7 @@ void MeasureBaseList::remove(MeasureBase* el)
             el->next()->setPrev(el->prev());
       else
             _last = el->prev();
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -193,6 +201,7 @@ void MeasureBaseList::insert(MeasureBase* fm, MeasureBase* lm)
             nm->setPrev(lm);
       else
             _last = lm;
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -214,6 +223,7 @@ void MeasureBaseList::remove(MeasureBase* fm, MeasureBase* lm)
             nm->setPrev(pm);
       else
             _last = pm;
+      invalidateIndex();
       }
 
 //---------------------------------------------------------
@@ -237,6 +247,50 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
             nb->setSystem(ob->system());
       foreach(Element* e, nb->el())
             e->setParent(nb);
+      invalidateIndex();
+      }
+
+//---------------------------------------------------------
+//   index
+//    all measures in tick order
+//---------------------------------------------------------
+
+const std::vector<Measure*>& MeasureBaseList::index() const
+      {
+      if (!_indexValid) {
+            _index.clear();
+            _index.reserve(_size);
+            for (MeasureBase* mb = _first; mb; mb = mb->next()) {
+                  if (mb->isMeasure())
+                        _index.push_back(toMeasure(mb));
+                  }
+            _indexValid = true;
+            }
+      return _index;
+      }
+
+//---------------------------------------------------------
+//   indexMM
+//    measures in tick order, with measures replaced by
+//    their multi measure rest if mmRests is set
+//---------------------------------------------------------
+
+const std::vector<Measure*>& MeasureBaseList::indexMM(bool mmRests) const
+      {
+      if (!_indexMMValid || _indexMMRests != mmRests) {
+            _indexMM.clear();
+            MeasureBase* mb = _first;
+            while (mb && !mb->isMeasure())
+                  mb = mb->next();
+            Measure* m = toMeasure(mb);
+            if (m && mmRests && m->hasMMRest())
+                  m = m->mmRest();
+            for (; m; m = m->nextMeasureMM())
+                  _indexMM.push_back(m);
+            _indexMMValid = true;
+            _indexMMRests = mmRests;
+            }
+      return _indexMM;
       }
 
 //---------------------------------------------------------
@@ -246,7 +300,9 @@ void MeasureBaseList::change(MeasureBase* ob, MeasureBase* nb)
 Score::Score()
    : ScoreElement(this), _is(this), _selection(this), _selectionFilter(this)
       {
+      validScoresMutex.lock();
       Score::validScores.insert(this);
+      validScoresMutex.unlock();
       _masterScore = 0;
       Layer l;
       l.name          = "default";
@@ -268,7 +324,9 @@ Score::Score()
 Score::Score(MasterScore* parent, bool forcePartStyle /* = true */)
    : Score{}
       {
+      validScoresMutex.lock();
       Score::validScores.insert(this);
+      validScoresMutex.unlock();
       _masterScore = parent;
       if (MScore::defaultStyleForParts())
             _style = *MScore::defaultStyleForParts();
@@ -309,7 +367,9 @@ Score::Score(MasterScore* parent, bool forcePartStyle /* = true */)
 Score::Score(MasterScore* parent, const MStyle& s)
    : Score{parent}
       {
+      validScoresMutex.lock();
       Score::validScores.insert(this);
+      validScoresMutex.unlock();
       _style  = s;
       }
 
@@ -338,7 +398,9 @@ Score::~Score()
 
       qDeleteAll(_parts);
       qDeleteAll(_staves);
+      validScoresMutex.lock();
       Score::validScores.erase(this);
+      validScoresMutex.unlock();
 //      qDeleteAll(_pages);         // TODO: check
       _masterScore = 0;
 
@@ -382,8 +444,13 @@ Score* Score::clone()
 void Score::onElementDestruction(Element* e)
       {
       Score* score = e->score();
-      if (!score || Score::validScores.find(score) == Score::validScores.end()) {
-            // No score or the score is already deleted
+      if (!score)
+            return;
+      validScoresMutex.lock();
+      bool valid = Score::validScores.find(score) != Score::validScores.end();
+      validScoresMutex.unlock();
+      if (!valid) {
+            // the score is already deleted
             return;
             }
       score->selection().remove(e);
@@ -820,12 +887,38 @@ void Score::setPlaylistDirty()
       masterScore()->setPlaylistDirty();
       }
 
+void Score::setPlaylistDirty(const Fraction& tick1, const Fraction& tick2)
+      {
+      masterScore()->setPlaylistDirty(tick1, tick2);
+      }
+
 //---------------------------------------------------------
 //   setPlaylistDirty
 //---------------------------------------------------------
 
 void MasterScore::setPlaylistDirty()
       {
+      _playlistDirty    = true;
+      _playlistDirtyAll = true;
+      _repeatList->setScoreChanged();
+      }
+
+//---------------------------------------------------------
+//   setPlaylistDirty
+//    only the playback of tick range [tick1, tick2] has
+//    changed
+//---------------------------------------------------------
+
+void MasterScore::setPlaylistDirty(const Fraction& tick1, const Fraction& tick2)
+      {
+      if (!_playlistDirty) {
+            _playlistDirtyTick1 = tick1;
+            _playlistDirtyTick2 = tick2;
+            }
+      else if (!_playlistDirtyAll) {
+            _playlistDirtyTick1 = qMin(_playlistDirtyTick1, tick1);
+            _playlistDirtyTick2 = qMax(_playlistDirtyTick2, tick2);
+            }
       _playlistDirty = true;
       _repeatList->setScoreChanged();
       }
@@ -4734,9 +4827,11 @@ Movements::~Movements()
 //    Usually pushes and pops to the undo stack are only
 //    valid inside a startCmd() - endCmd(). Exceptions
 //    occure during score loading.
+//    Scores may be loaded in worker threads, so the
+//    counter is atomic.
 //---------------------------------------------------------
 
-int ScoreLoad::_loading = 0;
+QAtomicInt ScoreLoad::_loading { 0 };
 
 }
 
@@ -35,6 +35,7 @@ class Audio;
 class BarLine;
 class Beam;
 class Bracket;
+class Breath;
 class BSymbol;
 class Chord;
 class ChordRest;
@@ -141,6 +142,13 @@ class MeasureBaseList {
       MeasureBase* _first;
       MeasureBase* _last;
 
+      // measures in tick order for binary search, rebuilt on demand
+      mutable std::vector<Measure*> _index;
+      mutable std::vector<Measure*> _indexMM;     // including multi measure rests
+      mutable bool _indexValid    { false };
+      mutable bool _indexMMValid  { false };
+      mutable bool _indexMMRests  { false };      // createMultiMeasureRests when _indexMM was built
+
       void push_back(MeasureBase* e);
       void push_front(MeasureBase* e);
 
@@ -148,13 +156,18 @@ class MeasureBaseList {
       MeasureBaseList();
       MeasureBase* first() const { return _first; }
       MeasureBase* last()  const { return _last; }
-      void clear()               { _first = _last = 0; _size = 0; }
+      void clear()               { _first = _last = 0; _size = 0; invalidateIndex(); }
       void add(MeasureBase*);
       void remove(MeasureBase*);
       void insert(MeasureBase*, MeasureBase*);
       void remove(MeasureBase*, MeasureBase*);
       void change(MeasureBase* o, MeasureBase* n);
       int size() const { return _size; }
+
+      void invalidateIndex()     { _indexValid = false; _indexMMValid = false; }
+      void invalidateIndexMM()   { _indexMMValid = false; }
+      const std::vector<Measure*>& index() const;
+      const std::vector<Measure*>& indexMM(bool mmRests) const;
       };
 
 //---------------------------------------------------------
@@ -382,6 +395,7 @@ class Score : public QObject, public ScoreElement {
 
    private:
       static std::set<Score*> validScores;
+      static QMutex validScoresMutex;     // scores may be created and deleted in worker threads
       int _linkId { 0 };
       MasterScore* _masterScore { 0 };
       QList<MuseScoreView*> viewer;
@@ -500,6 +514,16 @@ class Score : public QObject, public ScoreElement {
       void addAudioTrack();
       QList<Fraction> splitGapToMeasureBoundaries(ChordRest*, Fraction);
       void pasteChordRest(ChordRest* cr, const Fraction& tick, const Interval&);
+      bool pasteStaffChordRest(ChordRest* cr, QList<Chord*>& graceNotes, const Fraction& tick, const Fraction& dstTick,
+         const Fraction& tickLen, const Fraction& scale, const Interval& srcTranspose);
+      bool pasteTuplet(Tuplet* tuplet, Tuplet* parent, const Fraction& tick, const Fraction& scale);
+      Tuplet* pasteTupletEnd(Tuplet* tuplet);
+      void pasteAnnotation(Element* el, const Fraction& tick, int track);
+      void pasteClef(Clef* clef, const Fraction& tick);
+      void pasteBreath(Breath* breath, const Fraction& tick);
+      void rescalePastedSpanners(const std::vector<Spanner*>& oSpannerList, const Fraction& dstTick, const Fraction& oEndTick,
+         int dstStaff, int staves, const Fraction& scale);
+      void selectPastedRange(const Fraction& dstTick, const Fraction& tickLen, int dstStaff, int staves);
 
       void selectSingle(Element* e, int staffIdx);
       void selectAdd(Element* e);
@@ -764,6 +788,7 @@ class Score : public QObject, public ScoreElement {
       bool exportFile();
 
       void print(QPainter* printer, int page);
+      void drawPage(QPainter* painter, int page);
       ChordRest* getSelectedChordRest() const;
       QSet<ChordRest*> getSelectedChordRests() const;
       void getSelectedChordRest2(ChordRest** cr1, ChordRest** cr2) const;
@@ -820,6 +845,8 @@ class Score : public QObject, public ScoreElement {
       bool autosaveDirty() const     { return _autosaveDirty; }
       virtual bool playlistDirty() const;
       virtual void setPlaylistDirty();
+      void setPlaylistDirty(const Fraction& tick1, const Fraction& tick2);
+      void setPlaylistDirty(const CmdState&);
 
       void spell();
       void spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment);
@@ -834,12 +861,12 @@ class Score : public QObject, public ScoreElement {
       bool saveStyle(const QString&);
 
       QVariant styleV(Sid idx) const  { return style().value(idx);   }
-      Spatium  styleS(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return style().value(idx).value<Spatium>();  }
+      Spatium  styleS(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return Spatium(style().valueD(idx));  }
       qreal    styleP(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"Ms::Spatium")); return style().pvalue(idx); }
-      QString  styleSt(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"QString"));     return style().value(idx).toString(); }
-      bool     styleB(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool"));        return style().value(idx).toBool();  }
-      qreal    styleD(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double"));      return style().value(idx).toDouble();  }
-      int      styleI(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int"));         return style().value(idx).toInt();  }
+      QString  styleSt(Sid idx) const { Q_ASSERT(!strcmp(MStyle::valueType(idx),"QString"));     return style().valueSt(idx); }
+      bool     styleB(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"bool"));        return style().valueB(idx);  }
+      qreal    styleD(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"double"));      return style().valueD(idx);  }
+      int      styleI(Sid idx) const  { Q_ASSERT(!strcmp(MStyle::valueType(idx),"int"));         return style().valueI(idx);  }
 
       void setStyleValue(Sid sid, QVariant value) { style().set(sid, value);     }
       QString getTextStyleUserName(Tid tid);
@@ -877,6 +904,7 @@ class Score : public QObject, public ScoreElement {
 
       void cmdPaste(const QMimeData* ms, MuseScoreView* view, Fraction scale = Fraction(1, 1));
       bool pasteStaff(XmlReader&, Segment* dst, int staffIdx, Fraction scale = Fraction(1, 1));
+      bool pasteStaff(StaffListClone&, Segment* dst, int staffIdx, Fraction scale = Fraction(1, 1));
       void readAddConnector(ConnectorInfoReader* info, bool pasteMode) override;
       void pasteSymbols(XmlReader& e, ChordRest* dst);
       void renderMidi(EventMap* events, const SynthesizerState& synthState);
@@ -1139,6 +1167,7 @@ class Score : public QObject, public ScoreElement {
       QString accessibleInfo() const      { return accInfo;          }
 
       QImage createThumbnail();
+      QImage renderThumbnail();
       QString createRehearsalMarkText(RehearsalMark* current) const;
       QString nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
 
@@ -1205,6 +1234,9 @@ class MasterScore : public Score {
       RepeatList* _repeatList;
       bool _expandRepeats     { true };
       bool _playlistDirty     { true };
+      bool _playlistDirtyAll  { true };
+      Fraction _playlistDirtyTick1 { -1, 1 };   // changed tick range if not _playlistDirtyAll
+      Fraction _playlistDirtyTick2 { -1, 1 };
       QList<Excerpt*> _excerpts;
       std::vector<PartChannelSettingsLink> _playbackSettingsLinks;
       Score* _playbackScore = nullptr;
@@ -1257,7 +1289,11 @@ class MasterScore : public Score {
 
       virtual bool playlistDirty() const override                     { return _playlistDirty; }
       virtual void setPlaylistDirty() override;
-      void setPlaylistClean()                                         { _playlistDirty = false; }
+      void setPlaylistDirty(const Fraction& tick1, const Fraction& tick2);
+      void setPlaylistClean()                                         { _playlistDirty = false; _playlistDirtyAll = false; }
+      bool playlistDirtyAll() const                                   { return _playlistDirtyAll;   }
+      Fraction playlistDirtyTick1() const                             { return _playlistDirtyTick1; }
+      Fraction playlistDirtyTick2() const                             { return _playlistDirtyTick2; }
 
       void setExpandRepeats(bool expandRepeats);
       void updateRepeatListTempo();
@@ -1363,12 +1399,12 @@ class MasterScore : public Score {
 //---------------------------------------------------------
 
 class ScoreLoad {
-      static int _loading;
+      static QAtomicInt _loading;
 
    public:
-      ScoreLoad()  { ++_loading;  }
-      ~ScoreLoad() { --_loading; }
-      static bool loading() { return _loading > 0; }
+      ScoreLoad()  { _loading.ref();   }
+      ~ScoreLoad() { _loading.deref(); }
+      static bool loading() { return _loading.load() > 0; }
       };
 
 inline UndoStack* Score::undoStack() const             { return _masterScore->undoStack();      }
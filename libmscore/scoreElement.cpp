@@ -22,6 +22,7 @@
 namespace Ms {
 
 ElementStyle const ScoreElement::emptyStyle;
+void (*ScoreElement::deleteHook)(ScoreElement*) = nullptr;
 
 //
 // list has to be synchronized with ElementType enum
@@ -157,6 +158,8 @@ ScoreElement::ScoreElement(const ScoreElement& se)
 
 ScoreElement::~ScoreElement()
       {
+      if (deleteHook)
+            deleteHook(this);
       if (_links) {
             _links->removeOne(this);
             if (_links->empty()) {
@@ -827,7 +830,7 @@ QVariant ScoreElement::styleValue(Pid pid, Sid sid) const
             case P_TYPE::SP_REAL:
                   return score()->styleP(sid);
             case P_TYPE::POINT_SP: {
-                  QPointF val = score()->styleV(sid).toPointF() * score()->spatium();
+                  QPointF val = score()->style().valuePoint(sid) * score()->spatium();
                   if (isElement()) {
                         const Element* e = toElement(this);
                         if (e->staff() && !e->systemFlag())
@@ -836,7 +839,7 @@ QVariant ScoreElement::styleValue(Pid pid, Sid sid) const
                   return val;
                   }
             case P_TYPE::POINT_SP_MM: {
-                  QPointF val = score()->styleV(sid).toPointF();
+                  QPointF val = score()->style().valuePoint(sid);
                   if (sizeIsSpatiumDependent()) {
                         val *= score()->spatium();
                         if (isElement()) {
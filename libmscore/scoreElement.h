@@ -184,6 +184,8 @@ class ScoreElement {
 
       virtual ~ScoreElement();
 
+      static void (*deleteHook)(ScoreElement*);       // called on destruction if set (plugin wrapper cache)
+
       Score* score() const                 { return _score;      }
       MasterScore* masterScore() const;
       virtual void setScore(Score* s)      { _score = s;         }
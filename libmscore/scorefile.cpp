@@ -498,18 +498,15 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection)
       }
 
 //---------------------------------------------------------
-//   createThumbnail
+//   thumbnailImage
+//    a blank thumbnail for page, mag is set to the scale
+//    of the page
 //---------------------------------------------------------
 
-QImage Score::createThumbnail()
+static QImage thumbnailImage(Page* page, qreal& mag)
       {
-      LayoutMode mode = layoutMode();
-      setLayoutMode(LayoutMode::PAGE);
-      doLayout();
-
-      Page* page = pages().at(0);
       QRectF fr  = page->abbox();
-      qreal mag  = 256.0 / qMax(fr.width(), fr.height());
+      mag        = 256.0 / qMax(fr.width(), fr.height());
       int w      = int(fr.width() * mag);
       int h      = int(fr.height() * mag);
 
@@ -519,6 +516,21 @@ QImage Score::createThumbnail()
       pm.setDotsPerMeterX(dpm);
       pm.setDotsPerMeterY(dpm);
       pm.fill(0xffffffff);
+      return pm;
+      }
+
+//---------------------------------------------------------
+//   createThumbnail
+//---------------------------------------------------------
+
+QImage Score::createThumbnail()
+      {
+      LayoutMode mode = layoutMode();
+      setLayoutMode(LayoutMode::PAGE);
+      doLayout();
+
+      qreal mag;
+      QImage pm = thumbnailImage(pages().at(0), mag);
 
       double pr = MScore::pixelRatio;
       MScore::pixelRatio = 1.0;
@@ -539,6 +551,30 @@ QImage Score::createThumbnail()
       return pm;
       }
 
+//---------------------------------------------------------
+//   renderThumbnail
+//    Render the first page of the current layout. Unlike
+//    createThumbnail() this neither lays out the score nor
+//    sets MScore::pixelRatio or MScore::pdfPrinting, so a
+//    worker thread can use it on a score it owns.
+//---------------------------------------------------------
+
+QImage Score::renderThumbnail()
+      {
+      qreal mag;
+      QImage pm = thumbnailImage(pages().at(0), mag);
+
+      QPainter p(&pm);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag, mag);
+      _printing = true;
+      drawPage(&p, 0);
+      _printing = false;
+      p.end();
+      return pm;
+      }
+
 //---------------------------------------------------------
 //   saveCompressedFile
 //    file is already opened
@@ -557,9 +593,7 @@ bool Score::saveCompressedFile(QFileDevice* f, QFileInfo& info, bool onlySelecti
       xml.stag("rootfiles");
       xml.stag(QString("rootfile full-path=\"%1\"").arg(XmlWriter::xmlString(fn)));
       xml.etag();
-      for (ImageStoreItem* ip : imageStore) {
-            if (!ip->isUsed(this))
-                  continue;
+      for (ImageStoreItem* ip : imageStore.usedItems(this)) {
             QString path = QString("Pictures/") + ip->hashName();
             xml.tag("file", path);
             }
@@ -580,9 +614,7 @@ bool Score::saveCompressedFile(QFileDevice* f, QFileInfo& info, bool onlySelecti
 
       // save images
       //uz.addDirectory("Pictures");
-      for (ImageStoreItem* ip : imageStore) {
-            if (!ip->isUsed(this))
-                  continue;
+      for (ImageStoreItem* ip : imageStore.usedItems(this)) {
             QString path = QString("Pictures/") + ip->hashName();
             uz.addFile(path, ip->buffer());
             }
@@ -976,6 +1008,18 @@ void Score::print(QPainter* painter, int pageNo)
       {
       _printing  = true;
       MScore::pdfPrinting = true;
+      drawPage(painter, pageNo);
+      MScore::pdfPrinting = false;
+      _printing = false;
+      }
+
+//---------------------------------------------------------
+//   drawPage
+//    draw the visible elements of a page
+//---------------------------------------------------------
+
+void Score::drawPage(QPainter* painter, int pageNo)
+      {
       Page* page = pages().at(pageNo);
       QRectF fr  = page->abbox();
 
@@ -989,8 +1033,6 @@ void Score::print(QPainter* painter, int pageNo)
             e->draw(painter);
             painter->restore();
             }
-      MScore::pdfPrinting = false;
-      _printing = false;
       }
 
 //---------------------------------------------------------
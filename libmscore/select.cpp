@@ -786,6 +786,352 @@ QByteArray Selection::staffMimeData() const
       return buffer.buffer();
       }
 
+//---------------------------------------------------------
+//   ~StaffListClone
+//---------------------------------------------------------
+
+StaffListClone::~StaffListClone()
+      {
+      for (StaffClip& sc : staves) {
+            for (Item& item : sc.items)
+                  delete item.e;
+            }
+      for (TieClip& tc : ties)
+            delete tc.tie;
+      for (SlurClip& sc : slurs)
+            delete sc.slur;
+      qDeleteAll(spanners);
+      }
+
+//---------------------------------------------------------
+//   setScore
+//    must be called before the clones are cloned again
+//    for a paste into score
+//---------------------------------------------------------
+
+void StaffListClone::setScore(Score* score)
+      {
+      for (StaffClip& sc : staves) {
+            for (Item& item : sc.items) {
+                  if (item.e)
+                        item.e->setScore(score);
+                  }
+            }
+      for (TieClip& tc : ties)
+            tc.tie->setScore(score);
+      for (SlurClip& sc : slurs)
+            sc.slur->setScore(score);
+      for (Spanner* sp : spanners)
+            sp->setScore(score);
+      }
+
+//---------------------------------------------------------
+//   mapChord
+//    map chord src, its notes and grace chords to those
+//    of its copy dst
+//---------------------------------------------------------
+
+void StaffListClone::mapChord(const Chord* src, Chord* dst, QHash<const Element*, Element*>& map)
+      {
+      map.insert(src, dst);
+      const std::vector<Note*>& nl1 = src->notes();
+      std::vector<Note*>& nl2 = dst->notes();
+      for (size_t i = 0; i < nl1.size() && i < nl2.size(); ++i)
+            map.insert(nl1[i], nl2[i]);
+      const QVector<Chord*>& gl1 = src->graceNotes();
+      QVector<Chord*>& gl2 = dst->graceNotes();
+      for (int i = 0; i < gl1.size() && i < gl2.size(); ++i)
+            mapChord(gl1[i], gl2[i], map);
+      }
+
+//---------------------------------------------------------
+//   cloneForClip
+//---------------------------------------------------------
+
+static void unselect(void*, Element* e)
+      {
+      e->setSelected(false);
+      }
+
+static Element* cloneForClip(const Element* e)
+      {
+      Element* ne = e->clone();
+      ne->setParent(0);
+      ne->setSelected(false);
+      ne->scanElements(0, unselect);
+      return ne;
+      }
+
+//---------------------------------------------------------
+//   isPastedAnnotation
+//    annotation types pasteStaff() knows how to paste
+//---------------------------------------------------------
+
+static bool isPastedAnnotation(const Element* e)
+      {
+      switch (e->type()) {
+            case ElementType::HARMONY:
+            case ElementType::DYNAMIC:
+            case ElementType::SYMBOL:
+            case ElementType::FRET_DIAGRAM:
+            case ElementType::TREMOLOBAR:
+            case ElementType::MARKER:
+            case ElementType::JUMP:
+            case ElementType::IMAGE:
+            case ElementType::TEXT:
+            case ElementType::STAFF_TEXT:
+            case ElementType::TEMPO_TEXT:
+            case ElementType::FIGURED_BASS:
+            case ElementType::FERMATA:
+                  return true;
+            default:
+                  return false;
+            }
+      }
+
+//---------------------------------------------------------
+//   cloneTupletStart
+//    outer tuplets first, like writeTupletStart()
+//---------------------------------------------------------
+
+static void cloneTupletStart(const DurationElement* de, std::vector<StaffListClone::Item>& items, const Fraction& tick, int track)
+      {
+      Tuplet* tuplet = de->tuplet();
+      if (tuplet && tuplet->elements().front() == de) {
+            cloneTupletStart(tuplet, items, tick, track);
+            items.push_back({ StaffListClone::ItemType::TUPLET, tick, track, cloneForClip(tuplet) });
+            }
+      }
+
+//---------------------------------------------------------
+//   cloneTupletEnd
+//    inner tuplets first, like writeTupletEnd()
+//---------------------------------------------------------
+
+static void cloneTupletEnd(const DurationElement* de, std::vector<StaffListClone::Item>& items, int track)
+      {
+      Tuplet* tuplet = de->tuplet();
+      if (tuplet && tuplet->elements().back() == de) {
+            items.push_back({ StaffListClone::ItemType::END_TUPLET, Fraction(0, 1), track, 0 });
+            cloneTupletEnd(tuplet, items, track);
+            }
+      }
+
+//---------------------------------------------------------
+//   cloneChordRest
+//    return 0 if cr needs the xml form to be pasted
+//---------------------------------------------------------
+
+static ChordRest* cloneChordRest(const ChordRest* cr, QHash<const Element*, Element*>& clones,
+   std::vector<StaffListClone::TieClip>& ties)
+      {
+      Beam* beam = cr->beam();
+      if (beam && !beam->generated() && beam->elements().front() == cr)
+            return 0;
+      if (!cr->isChord()) {
+            ChordRest* ncr = toChordRest(cloneForClip(cr));
+            clones.insert(cr, ncr);
+            return ncr;
+            }
+      const Chord* chord = toChord(cr);
+      if (chord->tremolo() && chord->tremolo()->twoNotes())
+            return 0;
+      std::vector<const Chord*> chords { chord };
+      for (Chord* gc : chord->graceNotes())
+            chords.push_back(gc);
+      for (const Chord* c : chords) {
+            for (Note* n : c->notes()) {
+                  if (!n->spannerFor().empty() || !n->spannerBack().empty())
+                        return 0;
+                  }
+            }
+      Chord* nchord = toChord(cloneForClip(chord));
+      StaffListClone::mapChord(chord, nchord, clones);
+
+      // a cloned tie has no end note; keep it apart until we know
+      // whether its end note is copied, too
+      for (const Chord* c : chords) {
+            for (Note* n : c->notes()) {
+                  Note* nn = toNote(clones.value(n));
+                  Tie* tie = nn->tieFor();
+                  if (!tie)
+                        continue;
+                  nn->setTieFor(0);
+                  tie->setParent(0);
+                  if (n->tieFor() && n->tieFor()->endNote())
+                        ties.push_back({ tie, nn, n->tieFor()->endNote() });
+                  else
+                        delete tie;
+                  }
+            }
+      return nchord;
+      }
+
+//---------------------------------------------------------
+//   staffListClone
+//    clone the range selection the way staffMimeData()
+//    writes it; return 0 if the range holds something
+//    only the xml form can carry
+//---------------------------------------------------------
+
+StaffListClone* Selection::staffListClone() const
+      {
+      SelectionFilter filter = selectionFilter();
+      if (filter.filtered() != int(SelectionFilterType::ALL))
+            return 0;
+
+      Segment* seg1    = _startSegment;
+      Segment* seg2    = _endSegment;
+      Fraction endTick = seg2 ? seg2->tick() : _score->lastMeasure()->endTick();
+
+      // like writeSegments(), traverse the regular measures of mmrests
+      Measure* fm = seg1 ? seg1->measure() : 0;
+      Measure* lm = seg2 ? seg2->measure() : 0;
+      if (lm && lm->isMMRest()) {
+            lm = lm->mmRestLast();
+            if (!lm)
+                  return 0;
+            seg2 = lm->nextMeasure() ? lm->nextMeasure()->first() : _score->lastSegment();
+            }
+      if (fm && fm->isMMRest()) {
+            fm = fm->mmRestFirst();
+            if (fm)
+                  seg1 = fm->first();
+            }
+      if (!seg1)
+            return 0;
+
+      StaffListClone* clip = new StaffListClone;
+      clip->tickStart  = tickStart();
+      clip->ticks      = tickEnd() - tickStart();
+      clip->staffStart = staffStart();
+
+      QHash<const Element*, Element*> clones;   // copied chord/rests and notes to their clones
+      std::vector<StaffListClone::TieClip> ties;  // end notes not yet mapped
+      bool complete = true;
+
+      for (int staffIdx = staffStart(); staffIdx < staffEnd() && complete; ++staffIdx) {
+            int startTrack = staffIdx * VOICES;
+            int endTrack   = startTrack + VOICES;
+
+            clip->staves.emplace_back();
+            StaffListClone::StaffClip& sc = clip->staves.back();
+            sc.srcStaffIdx = staffIdx;
+            sc.transpose   = _score->staff(staffIdx)->part()->instrument(_startSegment->tick())->transpose();
+            for (int voice = 0; voice < VOICES; voice++) {
+                  int track = startTrack + voice;
+                  if (hasElementInTrack(_startSegment, _endSegment, track))
+                        sc.voiceOffset[voice] = (firstElementInTrack(_startSegment, _endSegment, track) - tickStart()).ticks();
+                  else
+                        sc.voiceOffset[voice] = -1;
+                  }
+
+            for (int track = startTrack; track < endTrack && complete; ++track) {
+                  for (Segment* segment = seg1; segment && segment != seg2; segment = segment->next1()) {
+                        if (!segment->enabled())
+                              continue;
+                        for (Element* a : segment->annotations()) {
+                              if (a->track() != track || a->generated() || a->systemFlag() || !isPastedAnnotation(a))
+                                    continue;
+                              sc.items.push_back({ StaffListClone::ItemType::ANNOTATION, segment->tick(), track, cloneForClip(a) });
+                              }
+                        Element* e = segment->element(track);
+                        if (!e || e->generated())
+                              continue;
+                        if (e->isChordRest()) {
+                              ChordRest* cr = toChordRest(e);
+                              ChordRest* ncr = cloneChordRest(cr, clones, ties);
+                              if (!ncr) {
+                                    complete = false;
+                                    break;
+                                    }
+                              cloneTupletStart(cr, sc.items, segment->tick(), track);
+                              sc.items.push_back({ StaffListClone::ItemType::CHORDREST, segment->tick(), track, ncr });
+                              cloneTupletEnd(cr, sc.items, track);
+                              }
+                        else if (e->isClef())
+                              sc.items.push_back({ StaffListClone::ItemType::CLEF, segment->tick(), track, cloneForClip(e) });
+                        else if (e->isBreath())
+                              sc.items.push_back({ StaffListClone::ItemType::BREATH, segment->tick(), track, cloneForClip(e) });
+                        }
+                  }
+            }
+
+      // ties and slurs are pasted only if both of their ends are
+      for (StaffListClone::TieClip& tc : ties) {
+            Note* endNote = toNote(clones.value(tc.endNote));
+            if (endNote) {
+                  tc.endNote = endNote;
+                  clip->ties.push_back(tc);
+                  }
+            else
+                  delete tc.tie;
+            }
+      if (!complete) {
+            delete clip;
+            return 0;
+            }
+
+      int strack = staffStart() * VOICES;
+      int etrack = staffEnd() * VOICES;
+      for (auto i : _score->spannerMap().findOverlapping(seg1->tick().ticks(), endTick.ticks())) {
+            Spanner* sp = i.value;
+            if (sp->generated())
+                  continue;
+            if (sp->isSlur()) {
+                  ChordRest* startCR = toChordRest(clones.value(sp->startElement()));
+                  ChordRest* endCR   = toChordRest(clones.value(sp->endElement()));
+                  if (!startCR || !endCR)
+                        continue;
+                  Slur* slur = toSlur(cloneForClip(sp));
+                  slur->setStartElement(0);
+                  slur->setEndElement(0);
+                  clip->slurs.push_back({ slur, startCR, endCR });
+                  }
+            else if (sp->isHairpin() || sp->isPedal() || sp->isOttava() || sp->isTrill() || sp->isTextLine()) {
+                  // the segment anchored lines writeSegments() writes both ends of
+                  int track2 = sp->track2() == -1 ? sp->track() : sp->track2();
+                  bool end;
+                  if (sp->anchor() == Spanner::Anchor::CHORD || sp->anchor() == Spanner::Anchor::NOTE)
+                        end = sp->tick2() < endTick;
+                  else
+                        end = sp->tick2() <= endTick;
+                  if (!end || sp->tick() < seg1->tick()
+                     || sp->track() < strack || sp->track() >= etrack
+                     || track2 < strack || track2 >= etrack)
+                        continue;
+                  Spanner* nsp = toSpanner(cloneForClip(sp));
+                  nsp->setStartElement(0);
+                  nsp->setEndElement(0);
+                  clip->spanners.push_back(nsp);
+                  }
+            }
+      return clip;
+      }
+
+//---------------------------------------------------------
+//   createMimeData
+//    clipboard data for the selection; a range is cloned
+//    for the paste within this process as well
+//---------------------------------------------------------
+
+QMimeData* Selection::createMimeData() const
+      {
+      QString type = mimeType();
+      if (type.isEmpty())
+            return 0;
+      QMimeData* md = 0;
+      if (isRange()) {
+            StaffListClone* clip = staffListClone();
+            if (clip)
+                  md = new StaffListMimeData(clip);
+            }
+      if (!md)
+            md = new QMimeData;
+      md->setData(type, mimeData());
+      return md;
+      }
+
 //---------------------------------------------------------
 //   symbolListMimeData
 //---------------------------------------------------------
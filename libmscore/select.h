@@ -16,6 +16,7 @@
 #include "pitchspelling.h"
 #include "mscore.h"
 #include "durationtype.h"
+#include "interval.h"
 
 namespace Ms {
 
@@ -28,6 +29,9 @@ class Segment;
 class Note;
 class Measure;
 class Chord;
+class Slur;
+class Spanner;
+class Tie;
 
 //---------------------------------------------------------
 //   ElementPattern
@@ -124,6 +128,75 @@ public:
       bool canSelectVoice(int track) const;
       };
 
+//---------------------------------------------------------
+//   StaffListClone
+//    a range selection cloned at copy time, so that a paste
+//    in the same process does not have to read it back from
+//    its xml clipboard form
+//    ticks are those of the source score
+//---------------------------------------------------------
+
+struct StaffListClone {
+      enum class ItemType : char {
+            TUPLET, END_TUPLET, CHORDREST, ANNOTATION, CLEF, BREATH
+            };
+      struct Item {
+            ItemType type;
+            Fraction tick;
+            int track;
+            Element* e;             // owned clone, 0 for END_TUPLET
+            };
+      struct StaffClip {
+            int srcStaffIdx;
+            Interval transpose;
+            int voiceOffset[VOICES];
+            std::vector<Item> items;      // in the order writeSegments() writes them
+            };
+      struct TieClip {
+            Tie* tie;
+            Note* startNote;        // notes of cloned chords
+            Note* endNote;
+            };
+      struct SlurClip {
+            Slur* slur;
+            ChordRest* startCR;     // cloned chord/rests
+            ChordRest* endCR;
+            };
+
+      Fraction tickStart;
+      Fraction ticks;
+      int staffStart;
+      std::vector<StaffClip> staves;
+      std::vector<TieClip> ties;
+      std::vector<SlurClip> slurs;
+      std::vector<Spanner*> spanners;     // segment anchored lines
+
+      StaffListClone() {}
+      StaffListClone(const StaffListClone&) = delete;
+      StaffListClone& operator=(const StaffListClone&) = delete;
+      ~StaffListClone();
+      void setScore(Score*);
+
+      static void mapChord(const Chord* src, Chord* dst, QHash<const Element*, Element*>& map);
+      };
+
+//---------------------------------------------------------
+//   StaffListMimeData
+//    clipboard data of a range selection; other applications
+//    get the xml, a paste in this process uses the clone
+//---------------------------------------------------------
+
+class StaffListMimeData : public QMimeData {
+      Q_OBJECT
+
+      StaffListClone* _staffList;
+
+   public:
+      StaffListMimeData(StaffListClone* sl) : _staffList(sl) {}
+      ~StaffListMimeData()                { delete _staffList; }
+      StaffListClone* staffList() const   { return _staffList; }
+      };
+
 //-------------------------------------------------------------------
 //   Selection
 //    For SelState::LIST state only visible elements can be selected
@@ -149,6 +222,7 @@ class Selection {
       int _activeTrack;
 
       QByteArray staffMimeData() const;
+      StaffListClone* staffListClone() const;
       QByteArray symbolListMimeData() const;
       SelectionFilter selectionFilter() const;
       bool canSelect(Element* e) const { return selectionFilter().canSelect(e); }
@@ -189,6 +263,7 @@ class Selection {
       void dump();
       QString mimeType() const;
       QByteArray mimeData() const;
+      QMimeData* createMimeData() const;
 
       Segment* startSegment() const     { return _startSegment; }
       Segment* endSegment() const       { return _endSegment;   }
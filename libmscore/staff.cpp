@@ -845,6 +845,11 @@ void Staff::setSmall(const Fraction& tick, bool val)
 
 SwingParameters Staff::swing(const Fraction& tick) const
       {
+      const SwingParameters* spp = _swingList.value(tick.ticks());
+      if (spp)
+            return *spp;
+
+      // no swing text before tick, use the style
       SwingParameters sp;
       int swingUnit = 0;
       QString unit = score()->styleSt(Sid::swingUnit);
@@ -858,13 +863,7 @@ SwingParameters Staff::swing(const Fraction& tick) const
             swingUnit = 0;
       sp.swingRatio = swingRatio;
       sp.swingUnit = swingUnit;
-      if (_swingList.empty())
-            return sp;
-      QMap<int, SwingParameters>::const_iterator i = _swingList.upperBound(tick.ticks());
-      if (i == _swingList.begin())
-            return sp;
-      --i;
-      return i.value();
+      return sp;
       }
 
 //---------------------------------------------------------
@@ -873,13 +872,8 @@ SwingParameters Staff::swing(const Fraction& tick) const
 
 int Staff::capo(const Fraction& tick) const
       {
-      if (_capoList.empty())
-            return 0;
-      QMap<int, int>::const_iterator i = _capoList.upperBound(tick.ticks());
-      if (i == _capoList.begin())
-            return 0;
-      --i;
-      return i.value();
+      const int* capo = _capoList.value(tick.ticks());
+      return capo ? *capo : 0;
       }
 
 //---------------------------------------------------------
@@ -888,13 +882,8 @@ int Staff::capo(const Fraction& tick) const
 
 int Staff::channel(const Fraction& tick,  int voice) const
       {
-      if (_channelList[voice].empty())
-            return 0;
-      QMap<int, int>::const_iterator i = _channelList[voice].upperBound(tick.ticks());
-      if (i == _channelList[voice].begin())
-            return 0;
-      --i;
-      return i.value();
+      const int* channel = _channelList[voice].value(tick.ticks());
+      return channel ? *channel : 0;
       }
 
 //---------------------------------------------------------
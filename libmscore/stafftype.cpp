@@ -30,6 +30,15 @@ namespace Ms {
 
 #define TAB_DEFAULT_DUR_YOFFS (-1.0)
 
+//---------------------------------------------------------
+//   metricsMutex
+//    the font metrics are computed on first use, which can
+//    happen while the pages of a score are drawn in parallel
+//    (see MuseScore::savePng)
+//---------------------------------------------------------
+
+static QMutex metricsMutex;
+
 QList<TablatureFretFont>     StaffType::_fretFonts      = QList<TablatureFretFont>();
 QList<TablatureDurationFont> StaffType::_durationFonts  = QList<TablatureDurationFont>();
 
@@ -415,6 +424,7 @@ void StaffType::setOnLines(bool val)
 
 void StaffType::setDurationMetrics() const
       {
+      QMutexLocker locker(&metricsMutex);
       if (_durationMetricsValid && _refDPI == DPI)           // metrics are still valid
             return;
 
@@ -444,6 +454,7 @@ void StaffType::setDurationMetrics() const
 
 void StaffType::setFretMetrics() const
       {
+      QMutexLocker locker(&metricsMutex);
       if (_fretMetricsValid && _refDPI == DPI)
             return;
 
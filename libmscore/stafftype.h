@@ -219,6 +219,8 @@ class StaffType {
       // TAB: internally managed variables
       // Note: values in RASTER UNITS are independent from score scaling and
       //    must be multiplied by magS() to be used in contexts using sp units
+      // The mutable metrics are only written by setDurationMetrics() and
+      //    setFretMetrics(), under a mutex: draw() may run in several threads
       mutable qreal _durationBoxH = 0.0;
       qreal mutable _durationBoxY = 0.0;          // the height and the y rect.coord. (relative to staff top line)
                                           // of a box bounding all duration symbols (raster units) internally computed:
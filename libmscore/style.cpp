@@ -2138,20 +2138,41 @@ Sid MStyle::styleIdx(const QString &name)
 MStyle::MStyle()
       {
       _customChordList = false;
-      for (const StyleType& t : styleTypes)
+      for (const StyleType& t : styleTypes) {
             _values[t.idx()] = t.defaultValue();
+            setTypedValue(t.idx());
+            }
       };
 
+//---------------------------------------------------------
+//   setTypedValue
+//    update the typed copies of _values[idx]
+//---------------------------------------------------------
+
+void MStyle::setTypedValue(int idx)
+      {
+      const QVariant& v = _values[idx];
+      const char* type  = styleTypes[idx].valueType();
+      if (!strcmp(type, "Ms::Spatium"))
+            _doubleValues[idx] = v.value<Spatium>().val();
+      else
+            _doubleValues[idx] = v.toDouble();
+      _intValues[idx]    = v.toInt();
+      _boolValues[idx]   = v.toBool();
+      _stringValues[idx] = !strcmp(type, "QString") ? v.toString() : QString();
+      _pointValues[idx]  = !strcmp(type, "QPointF") ? v.toPointF() : QPointF();
+      }
+
 //---------------------------------------------------------
 //   precomputeValues
 //---------------------------------------------------------
 
 void MStyle::precomputeValues()
       {
-      qreal _spatium = value(Sid::spatium).toDouble();
+      qreal _spatium = valueD(Sid::spatium);
       for (const StyleType& t : styleTypes) {
             if (!strcmp(t.valueType(), "Ms::Spatium"))
-                  _precomputedValues[t.idx()] = _values[t.idx()].value<Spatium>().val() * _spatium;
+                  _precomputedValues[t.idx()] = _doubleValues[t.idx()] * _spatium;
             }
       }
 
@@ -2209,12 +2230,13 @@ void MStyle::set(const Sid t, const QVariant& val)
       {
       const int idx = int(t);
       _values[idx] = val;
+      setTypedValue(idx);
       if (t == Sid::spatium)
             precomputeValues();
       else {
             if (!strcmp(styleTypes[idx].valueType(), "Ms::Spatium")) {
-                  qreal _spatium = value(Sid::spatium).toDouble();
-                  _precomputedValues[idx] = _values[idx].value<Spatium>().val() * _spatium;
+                  qreal _spatium = valueD(Sid::spatium);
+                  _precomputedValues[idx] = _doubleValues[idx] * _spatium;
                   }
             }
       }
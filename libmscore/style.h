@@ -1125,6 +1125,16 @@ class MStyle {
       std::array<QVariant, int(Sid::STYLES)> _values;
       std::array<qreal, int(Sid::STYLES)> _precomputedValues;
 
+      // typed copies of _values for the accessors used during layout,
+      // updated whenever a value is set
+      std::array<qreal, int(Sid::STYLES)> _doubleValues;      // Spatium values hold val()
+      std::array<int, int(Sid::STYLES)> _intValues;
+      std::array<bool, int(Sid::STYLES)> _boolValues;
+      std::array<QString, int(Sid::STYLES)> _stringValues;
+      std::array<QPointF, int(Sid::STYLES)> _pointValues;
+
+      void setTypedValue(int idx);
+
       ChordList _chordList;
       bool _customChordList;        // if true, chordlist will be saved as part of score
 
@@ -1134,6 +1144,11 @@ class MStyle {
       void precomputeValues();
       QVariant value(Sid idx) const;
       qreal pvalue(Sid idx) const    { return _precomputedValues[int(idx)]; }
+      qreal valueD(Sid idx) const                 { return _doubleValues[int(idx)]; }
+      int valueI(Sid idx) const                   { return _intValues[int(idx)];    }
+      bool valueB(Sid idx) const                  { return _boolValues[int(idx)];   }
+      const QString& valueSt(Sid idx) const       { return _stringValues[int(idx)]; }
+      const QPointF& valuePoint(Sid idx) const    { return _pointValues[int(idx)];  }
       void set(Sid idx, const QVariant& v);
 
       bool isDefault(Sid idx) const;
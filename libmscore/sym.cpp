@@ -23,6 +23,15 @@
 
 static FT_Library ftlib;
 
+//---------------------------------------------------------
+//   glyphMutex
+//    the FreeType faces and the glyph caches are shared by
+//    all threads drawing symbols (see MuseScore::savePng)
+//    or creating scores (see ScoreBrowser thumbnails)
+//---------------------------------------------------------
+
+static QMutex glyphMutex;
+
 namespace Ms {
 
 
@@ -5641,13 +5650,8 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                   qDebug("ScoreFont::draw: invalid sym %d", int(id));
             return;
             }
-      int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-      if (rv) {
-            qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-            return;
-            }
-
       if (MScore::pdfPrinting) {
+            QMutexLocker locker(&glyphMutex);
             if (font == 0) {
                   QString s(_fontPath+_filename);
                   if (-1 == QFontDatabase::addApplicationFont(s)) {
@@ -5661,11 +5665,13 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                   font->setStyleStrategy(QFont::NoFontMerging);
                   font->setHintingPreference(QFont::PreferVerticalHinting);
                   }
+            QFont f(*font);
+            locker.unlock();
             qreal size = 20.0 * MScore::pixelRatio;
-            font->setPointSize(size);
+            f.setPointSize(size);
             QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
             painter->scale(mag.width(), mag.height());
-            painter->setFont(*font);
+            painter->setFont(f);
             painter->drawText(QPointF(pos.x() * imag.width(), pos.y() * imag.height()), toString(id));
             painter->scale(imag.width(), imag.height());
             return;
@@ -5682,9 +5688,18 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
       int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
       GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-      GlyphPixmap* pm = cache->object(gk);
+      GlyphImage gi;
 
-      if (!pm) {
+      QMutexLocker locker(&glyphMutex);
+      GlyphImage* cached = cache->object(gk);
+      if (cached)
+            gi = *cached;
+      else {
+            int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+            if (rv) {
+                  qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+                  return;
+                  }
             FT_Matrix matrix {
                   scale16X, 0,
                   0,       scale16Y
@@ -5704,6 +5719,7 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
 
             if (bm->width == 0 || bm->rows == 0) {
                   qDebug("zero glyph, id %d", int(id));
+                  FT_Done_Glyph(glyph);
                   return;
                   }
             QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
@@ -5718,15 +5734,16 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
                         *dst++ = color.rgba();
                         }
                   }
-            pm = new GlyphPixmap;
-            pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-            pm->pm.setDevicePixelRatio(worldScale);
-            pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-            if (!cache->insert(gk, pm))
+            // a QImage, unlike a QPixmap, can be drawn outside of the gui thread
+            gi.image = img.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+            gi.image.setDevicePixelRatio(worldScale);
+            gi.offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
+            if (!cache->insert(gk, new GlyphImage(gi)))
                   qDebug("cannot cache glyph");
             FT_Done_Glyph(glyph);
             }
-      painter->drawPixmap(pos + pm->offset, pm->pm);
+      locker.unlock();
+      painter->drawImage(pos + gi.offset, gi.image);
       }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -5880,7 +5897,7 @@ void ScoreFont::load()
             qDebug("freetype: cannot create face <%s>: %d", qPrintable(facePath), rval);
             return;
             }
-      cache = new QCache<GlyphKey, GlyphPixmap>(100);
+      cache = new QCache<GlyphKey, GlyphImage>(100);
 
       qreal pixelSize = 200.0;
       FT_Set_Pixel_Sizes(face, 0, int(pixelSize+.5));
@@ -6194,6 +6211,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
             return fallbackFont();
             }
 
+      QMutexLocker locker(&glyphMutex);
       if (!f->face)
             f->load();
       return f;
@@ -6206,6 +6224,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
       {
       ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
+      QMutexLocker locker(&glyphMutex);
       if (!f->face)
             f->load();
       return f;
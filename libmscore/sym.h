@@ -2750,8 +2750,8 @@ struct GlyphKey {
       bool operator==(const GlyphKey&) const;
       };
 
-struct GlyphPixmap {
-      QPixmap pm;
+struct GlyphImage {
+      QImage image;
       QPointF offset;
       };
 
@@ -2772,7 +2772,7 @@ class ScoreFont {
       QString _fontPath;
       QString _filename;
       QByteArray fontImage;
-      QCache<GlyphKey, GlyphPixmap>* cache { 0 };
+      QCache<GlyphKey, GlyphImage>* cache { 0 };
       std::list<std::pair<Sid, QVariant>> _engravingDefaults;
       double _textEnclosureThickness = 0;
       mutable QFont* font { 0 };
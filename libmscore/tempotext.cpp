@@ -255,19 +255,23 @@ void TempoText::undoChangeProperty(Pid id, const QVariant& v, PropertyFlags ps)
 
 void TempoText::updateTempo()
       {
-      // cache regexp, they are costly to create
+      // cache regexp, they are costly to create;
+      // scores may be read in worker threads
       static QHash<QString, QRegExp> regexps;
       static QHash<QString, QRegExp> regexps2;
+      static QMutex mutex;
       QString s = plainText();
       s.replace(",", ".");
       s.replace("<sym>space</sym>"," ");
       for (const TempoPattern& pa : tp) {
             QRegExp re;
+            mutex.lock();
             if (!regexps.contains(pa.pattern)) {
                   re = QRegExp(QString("%1\\s*=\\s*(\\d+[.]{0,1}\\d*)\\s*").arg(pa.pattern));
                   regexps[pa.pattern] = re;
                   }
             re = regexps.value(pa.pattern);
+            mutex.unlock();
             if (re.indexIn(s) != -1) {
                   QStringList sl = re.capturedTexts();
                   if (sl.size() == 2) {
@@ -285,11 +289,13 @@ void TempoText::updateTempo()
                  for (const TempoPattern& pa2 : tp) {
                        QString key = QString("%1_%2").arg(pa.pattern).arg(pa2.pattern);
                        QRegExp re2;
+                       mutex.lock();
                        if (!regexps2.contains(key)) {
                              re2 = QRegExp(QString("%1\\s*=\\s*%2\\s*").arg(pa.pattern).arg(pa2.pattern));
                              regexps2[key] = re2;
                              }
                        re2 = regexps2.value(key);
+                       mutex.unlock();
                        if (re2.indexIn(s) != -1) {
                              _relative = pa2.f / pa.f;
                              _isRelative = true;
@@ -122,8 +122,8 @@ QRectF TextCursor::cursorRect() const
       const TextBlock& tline       = curLine();
       const TextFragment* fragment = tline.fragment(column());
 
-      QFont _font  = fragment ? fragment->font(_text) : _text->font();
-      qreal ascent = QFontMetricsF(_font, MScore::paintDevice()).ascent();
+      qreal ascent = fragment ? fragment->textFont(_text).metrics.ascent()
+                              : QFontMetricsF(_text->font(), MScore::paintDevice()).ascent();
       qreal h = ascent;
       qreal x = tline.xpos(column(), _text);
       qreal y = tline.y() - ascent * .9;
@@ -478,15 +478,82 @@ bool TextFragment::operator ==(const TextFragment& f) const
       return format == f.format && text == f.text;
       }
 
+//---------------------------------------------------------
+//   TextFontKey
+//---------------------------------------------------------
+
+struct TextFontKey {
+      QString family;
+      qreal size;
+      FontStyle style;
+
+      bool operator==(const TextFontKey& k) const {
+            return size == k.size && style == k.style && family == k.family;
+            }
+      };
+
+static uint qHash(const TextFontKey& k, uint seed = 0)
+      {
+      return ::qHash(k.family, seed) ^ ::qHash(k.size, seed) ^ uint(k.style);
+      }
+
+//---------------------------------------------------------
+//   TextFont
+//    a resolved text font and its metrics on the layout
+//    paint device
+//---------------------------------------------------------
+
+struct TextFont {
+      QFont font;
+      QFontMetricsF metrics;
+      FontStyle style;
+
+      TextFont(const QFont& f, FontStyle s) : font(f), metrics(f, MScore::paintDevice()), style(s) {}
+      };
+
+//---------------------------------------------------------
+//   cachedTextFont
+//    Fonts are shared by all fragments with the same family,
+//    size and style; the size already includes spatium
+//    scaling. The cache is dropped when it grows too large,
+//    e.g. after many spatium changes.
+//---------------------------------------------------------
+
+static const int MAX_CACHED_TEXT_FONTS = 1024;
+
+static TextFont cachedTextFont(const QString& family, qreal size, FontStyle style)
+      {
+      static QHash<TextFontKey, TextFont> fonts;
+      static QMutex mutex;
+
+      TextFontKey key { family, size, style };
+      QMutexLocker lock(&mutex);
+      auto i = fonts.constFind(key);
+      if (i != fonts.constEnd())
+            return *i;
+      if (fonts.size() >= MAX_CACHED_TEXT_FONTS)
+            fonts.clear();
+
+      QFont font;
+      font.setFamily(family);
+      font.setUnderline(style & FontStyle::Underline);
+      font.setBold(style & FontStyle::Bold);
+      font.setItalic(style & FontStyle::Italic);
+      font.setPointSizeF(size);
+      return *fonts.insert(key, TextFont(font, style));
+      }
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
 
 void TextFragment::draw(QPainter* p, const TextBase* t) const
       {
-      QFont f(font(t));
-      f.setPointSizeF(f.pointSizeF() * MScore::pixelRatio);
-      p->setFont(f);
+      TextFont tf = textFont(t);
+      if (MScore::pixelRatio == 1.0)
+            p->setFont(tf.font);
+      else
+            p->setFont(cachedTextFont(tf.font.family(), tf.font.pointSizeF() * MScore::pixelRatio, tf.style).font);
       p->drawText(pos, text);
       }
 
@@ -496,58 +563,93 @@ void TextFragment::draw(QPainter* p, const TextBase* t) const
 
 QFont TextFragment::font(const TextBase* t) const
       {
-      QFont font;
+      return textFont(t).font;
+      }
 
+//---------------------------------------------------------
+//   textFont
+//---------------------------------------------------------
+
+TextFont TextFragment::textFont(const TextBase* t) const
+      {
       qreal m = format.fontSize();
 
       if (t->sizeIsSpatiumDependent())
             m *= t->spatium() / SPATIUM20;
       if (format.valign() != VerticalAlignment::AlignNormal)
             m *= subScriptSize;
-      font.setUnderline(format.underline() || format.preedit());
+      Q_ASSERT(m > 0.0);
 
-      QString family;
-      if (format.fontFamily() == "ScoreText") {
-            family = t->score()->styleSt(Sid::MusicalTextFont);
-
-            // check if all symbols are available
-            font.setFamily(family);
-            QFontMetricsF fm(font);
-
-            bool fail = false;
-            for (int i = 0; i < text.size(); ++i) {
-                  QChar c = text[i];
-                  if (c.isHighSurrogate()) {
-                        if (i+1 == text.size())
-                              qFatal("bad string");
-                        QChar c2 = text[i+1];
-                        ++i;
-                        uint v = QChar::surrogateToUcs4(c, c2);
-                        if (!fm.inFontUcs4(v)) {
-                              fail = true;
-                              break;
-                              }
+      FontStyle style = format.style();
+      if (format.preedit())
+            style = style + FontStyle::Underline;
+
+      if (format.fontFamily() != "ScoreText")
+            return cachedTextFont(format.fontFamily(), m, style);
+
+      TextFont tf = cachedTextFont(t->score()->styleSt(Sid::MusicalTextFont), m, style);
+
+      // check if all symbols are available
+      const QFontMetricsF& fm = tf.metrics;
+      bool fail = false;
+      for (int i = 0; i < text.size(); ++i) {
+            QChar c = text[i];
+            if (c.isHighSurrogate()) {
+                  if (i+1 == text.size())
+                        qFatal("bad string");
+                  QChar c2 = text[i+1];
+                  ++i;
+                  uint v = QChar::surrogateToUcs4(c, c2);
+                  if (!fm.inFontUcs4(v)) {
+                        fail = true;
+                        break;
                         }
-                  else {
-                        if (!fm.inFont(c)) {
-                              fail = true;
-                              break;
-                              }
+                  }
+            else {
+                  if (!fm.inFont(c)) {
+                        fail = true;
+                        break;
                         }
                   }
-            if (fail)
-                  family = ScoreFont::fallbackTextFont();
             }
-      else
-            family = format.fontFamily();
+      if (fail)
+            return cachedTextFont(ScoreFont::fallbackTextFont(), m, style);
+      return tf;
+      }
 
-      font.setFamily(family);
-      font.setBold(format.bold());
-      font.setItalic(format.italic());
-      Q_ASSERT(m > 0.0);
+//---------------------------------------------------------
+//   measure
+//    update the cached extents if text or font changed
+//---------------------------------------------------------
 
-      font.setPointSizeF(m);
-      return font;
+void TextFragment::measure(const TextFont& tf) const
+      {
+      if (_measuredText == text && _measuredFont == tf.font)
+            return;
+      _measuredText      = text;
+      _measuredFont      = tf.font;
+      _width             = tf.metrics.width(text);
+      _tightBoundingRect = tf.metrics.tightBoundingRect(text);
+      }
+
+//---------------------------------------------------------
+//   width
+//---------------------------------------------------------
+
+qreal TextFragment::width(const TextFont& tf) const
+      {
+      measure(tf);
+      return _width;
+      }
+
+//---------------------------------------------------------
+//   tightBoundingRect
+//---------------------------------------------------------
+
+QRectF TextFragment::tightBoundingRect(const TextFont& tf) const
+      {
+      measure(tf);
+      return _tightBoundingRect;
       }
 
 //---------------------------------------------------------
@@ -609,7 +711,8 @@ void TextBlock::layout(TextBase* t)
       else {
             for (TextFragment& f : _fragments) {
                   f.pos.setX(x);
-                  QFontMetricsF fm(f.font(t), MScore::paintDevice());
+                  TextFont tf = f.textFont(t);
+                  const QFontMetricsF& fm = tf.metrics;
                   if (f.format.valign() != VerticalAlignment::AlignNormal) {
                         qreal voffset = fm.xHeight() / subScriptSize;   // use original height
                         if (f.format.valign() == VerticalAlignment::AlignSubScript)
@@ -620,8 +723,8 @@ void TextBlock::layout(TextBase* t)
                         }
                   else
                         f.pos.setY(0.0);
-                  qreal w  = fm.width(f.text);
-                  _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
+                  qreal w  = f.width(tf);
+                  _bbox   |= f.tightBoundingRect(tf).translated(f.pos);
                   x += w;
                   _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
                   }
@@ -649,7 +752,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
       for (const TextFragment& f : _fragments) {
             if (column == col)
                   return f.pos.x();
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFontMetricsF fm = f.textFont(t).metrics;
             int idx = 0;
             for (const QChar& c : f.text) {
                   ++idx;
@@ -740,11 +843,11 @@ int TextBlock::column(qreal x, TextBase* t) const
             if (x <= f.pos.x())
                   return col;
             qreal px = 0.0;
+            const QFontMetricsF fm = f.textFont(t).metrics;
             for (const QChar& c : f.text) {
                   ++idx;
                   if (c.isHighSurrogate())
                         continue;
-                  QFontMetricsF fm(f.font(t), MScore::paintDevice());
                   qreal xo = fm.width(f.text.left(idx));
                   if (x <= f.pos.x() + px + (xo-px)*.5)
                         return col;
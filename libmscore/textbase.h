@@ -24,6 +24,7 @@ struct SymCode;
 class TextBase;
 class TextBlock;
 class ChangeText;
+struct TextFont;
 
 //---------------------------------------------------------
 //   FrameType
@@ -140,6 +141,12 @@ class TextCursor {
 //---------------------------------------------------------
 
 class TextFragment {
+      mutable QFont _measuredFont;        // font and text the cached
+      mutable QString _measuredText;      // extents were measured with
+      mutable qreal _width { 0.0 };
+      mutable QRectF _tightBoundingRect;
+
+      void measure(const TextFont&) const;
 
    public:
       mutable CharFormat format;
@@ -154,6 +161,9 @@ class TextFragment {
       TextFragment split(int column);
       void draw(QPainter*, const TextBase*) const;
       QFont font(const TextBase*) const;
+      TextFont textFont(const TextBase*) const;
+      qreal width(const TextFont&) const;
+      QRectF tightBoundingRect(const TextFont&) const;
       int columns() const;
       void changeFormat(FormatId id, QVariant data);
       };
@@ -553,6 +553,39 @@ void CloneVoice::redo(EditData*)
             s->cloneVoice(strack, dtrack, sf, ticks, linked, first);
       }
 
+//---------------------------------------------------------
+//   changesLaterPlayback
+//    Return true if changing e can change playback outside
+//    of the tick range layout is done for: dynamics and
+//    staff text settings apply to all following notes,
+//    spanners to their whole length and measures, jumps
+//    and markers can change the repeat list.
+//---------------------------------------------------------
+
+static bool changesLaterPlayback(ScoreElement* e)
+      {
+      if (!e->isElement())
+            return true;
+      if (e->isSpannerSegment())
+            e = toSpannerSegment(e)->spanner();
+      if (e->isSpanner())
+            return !e->isSlur() && !e->isTie();
+      switch (e->type()) {
+            case ElementType::DYNAMIC:
+            case ElementType::STAFF_TEXT:
+            case ElementType::SYSTEM_TEXT:
+            case ElementType::TEMPO_TEXT:
+            case ElementType::INSTRUMENT_CHANGE:
+            case ElementType::JUMP:
+            case ElementType::MARKER:
+            case ElementType::BAR_LINE:
+            case ElementType::MEASURE:
+                  return true;
+            default:
+                  return false;
+            }
+      }
+
 //---------------------------------------------------------
 //   AddElement
 //---------------------------------------------------------
@@ -606,6 +639,8 @@ static void undoAddTuplet(DurationElement* cr)
 
 void AddElement::endUndoRedo(bool isUndo) const
       {
+      if (changesLaterPlayback(element))
+            element->score()->setPlaylistDirty();
       if (element->isChordRest()) {
             if (isUndo)
                   undoRemoveTuplet(toChordRest(element));
@@ -734,6 +769,8 @@ void RemoveElement::undo(EditData*)
       {
       if (!element->isTuplet())
             element->score()->addElement(element);
+      if (changesLaterPlayback(element))
+            element->score()->setPlaylistDirty();
       if (element->isChordRest()) {
             if (element->isChord()) {
                   Chord* chord = toChord(element);
@@ -757,6 +794,8 @@ void RemoveElement::redo(EditData*)
       {
       if (!element->isTuplet())
             element->score()->removeElement(element);
+      if (changesLaterPlayback(element))
+            element->score()->setPlaylistDirty();
       if (element->isChordRest()) {
             undoRemoveTuplet(toChordRest(element));
             if (element->isChord()) {
@@ -2014,6 +2053,8 @@ void ChangeProperty::flip(EditData*)
 
       element->setProperty(id, property);
       element->setPropertyFlags(id, flags);
+      if (changesLaterPlayback(element))
+            element->score()->setPlaylistDirty();
       property = v;
       flags = ps;
       }
@@ -113,25 +113,8 @@ static void removeRepeatMarkings(Score* score)
 
 void createExcerpts(MasterScore* cs, QList<Excerpt *> excerpts)
       {
-      // borrowed from musescore.cpp endsWith(".pdf")
-      for (Excerpt* e: excerpts) {
-            Score* nscore = new Score(e->oscore());
-            e->setPartScore(nscore);
-            nscore->style().set(Sid::createMultiMeasureRests, true);
-            cs->startCmd();
-            cs->undo(new AddExcerpt(e));
-            Excerpt::createExcerpt(e);
-
-            // borrowed from excerptsdialog.cpp
-            // a new excerpt is created in AddExcerpt, make sure the parts are filed
-            for (Excerpt* ee : e->oscore()->excerpts())
-                  if (ee->partScore() == nscore && ee != e) {
-                        ee->parts().clear();
-                        ee->parts().append(e->parts());
-                        }
-
-            cs->endCmd();
-            }
+      // the unrolled score is a new copy, nothing to undo
+      Excerpt::createExcerpts(cs, excerpts, false);
       }
 
 //---------------------------------------------------------
@@ -40,6 +40,28 @@ QRectF handleRect(const QPointF& pos)
       return QRectF(pos.x()-4, pos.y()-4, 8, 8);
       }
 
+//---------------------------------------------------------
+//   searchMeasure
+//    binary search for the last measure starting at or
+//    before tick; past the last measure tick must not be
+//    behind its end
+//---------------------------------------------------------
+
+static Measure* searchMeasure(const std::vector<Measure*>& index, const Fraction& tick, Measure** last)
+      {
+      auto i = std::upper_bound(index.begin(), index.end(), tick,
+         [](const Fraction& t, const Measure* m) { return t < m->tick(); });
+      *last = index.empty() ? 0 : index.back();
+      if (i == index.begin()) {
+            Q_ASSERT(index.empty());
+            return 0;
+            }
+      Measure* m = *(i - 1);
+      if (i == index.end() && tick > m->endTick())
+            return 0;
+      return m;
+      }
+
 //---------------------------------------------------------
 //   tick2measure
 //---------------------------------------------------------
@@ -51,19 +73,11 @@ Measure* Score::tick2measure(const Fraction& tick) const
       if (tick <= Fraction(0,1))
             return firstMeasure();
 
-      Measure* lm = 0;
-      for (Measure* m = firstMeasure(); m; m = m->nextMeasure()) {
-            if (tick < m->tick()) {
-                  Q_ASSERT(lm);
-                  return lm;
-                  }
-            lm = m;
-            }
-      // check last measure
-      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
-            return lm;
-      qDebug("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-      return 0;
+      Measure* lm;
+      Measure* m = searchMeasure(_measures.index(), tick, &lm);
+      if (!m)
+            qDebug("tick2measure %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+      return m;
       }
 
 //---------------------------------------------------------
@@ -78,20 +92,11 @@ Measure* Score::tick2measureMM(const Fraction& t) const
       if (tick < Fraction(0,1))
             tick = Fraction(0,1);
 
-      Measure* lm = 0;
-
-      for (Measure* m = firstMeasureMM(); m; m = m->nextMeasureMM()) {
-            if (tick < m->tick()) {
-                  Q_ASSERT(lm);
-                  return lm;
-                  }
-            lm = m;
-            }
-      // check last measure
-      if (lm && (tick >= lm->tick()) && (tick <= lm->endTick()))
-            return lm;
-      qDebug("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
-      return 0;
+      Measure* lm;
+      Measure* m = searchMeasure(_measures.indexMM(styleB(Sid::createMultiMeasureRests)), tick, &lm);
+      if (!m)
+            qDebug("tick2measureMM %d (max %d) not found", tick.ticks(), lm ? lm->tick().ticks() : -1);
+      return m;
       }
 
 //---------------------------------------------------------
@@ -100,6 +105,12 @@ Measure* Score::tick2measureMM(const Fraction& t) const
 
 MeasureBase* Score::tick2measureBase(const Fraction& tick) const
       {
+      // frames have no length, so only the measure found by the index
+      // can contain tick
+      Measure* lm;
+      Measure* m = searchMeasure(_measures.index(), tick, &lm);
+      if (m && tick >= m->tick() && tick < m->endTick())
+            return m;
       for (MeasureBase* mb = first(); mb; mb = mb->next()) {
             Fraction st = mb->tick();
             Fraction l  = mb->ticks();
@@ -60,6 +60,97 @@ class LinksIndexer {
       int assignLocalIndex(const Location& mainElementInfo);
       };
 
+//---------------------------------------------------------
+//   XmlTag
+//    element names known to the hot read paths
+//    (readProperties() of notes, chords and elements),
+//    mapped to an enum once per start element so that
+//    they can be dispatched with a switch
+//---------------------------------------------------------
+
+#define XML_TAGS(X) \
+      X(ACCIDENTAL,             "Accidental") \
+      X(ACCIACCATURA,           "acciaccatura") \
+      X(APPOGGIATURA,           "appoggiatura") \
+      X(ARPEGGIO,               "Arpeggio") \
+      X(ARTICULATION,           "Articulation") \
+      X(AUTOPLACE,              "autoplace") \
+      X(BEAM_MODE,              "BeamMode") \
+      X(BEND,                   "Bend") \
+      X(CHORD_LINE,             "ChordLine") \
+      X(COLOR,                  "color") \
+      X(DOT_POSITION,           "dotPosition") \
+      X(DOTS,                   "dots") \
+      X(DURATION,               "duration") \
+      X(DURATION_TYPE,          "durationType") \
+      X(EVENTS,                 "Events") \
+      X(FINGERING,              "Fingering") \
+      X(FIXED,                  "fixed") \
+      X(FIXED_LINE,             "fixedLine") \
+      X(FRET,                   "fret") \
+      X(GHOST,                  "ghost") \
+      X(GRACE4,                 "grace4") \
+      X(GRACE16,                "grace16") \
+      X(GRACE32,                "grace32") \
+      X(GRACE8_AFTER,           "grace8after") \
+      X(GRACE16_AFTER,          "grace16after") \
+      X(GRACE32_AFTER,          "grace32after") \
+      X(HEAD,                   "head") \
+      X(HEAD_TYPE,              "headType") \
+      X(HOOK,                   "Hook") \
+      X(IMAGE,                  "Image") \
+      X(LEADING_SPACE,          "leadingSpace") \
+      X(LID,                    "lid") \
+      X(LINE,                   "line") \
+      X(LINKED,                 "linked") \
+      X(LINKED_MAIN,            "linkedMain") \
+      X(LYRICS,                 "Lyrics") \
+      X(MIN_DISTANCE,           "minDistance") \
+      X(MIRROR,                 "mirror") \
+      X(NO_STEM,                "noStem") \
+      X(NOTE,                   "Note") \
+      X(NOTE_DOT,               "NoteDot") \
+      X(OFFSET,                 "offset") \
+      X(PITCH,                  "pitch") \
+      X(PLACEMENT,              "placement") \
+      X(PLAY,                   "play") \
+      X(POS,                    "pos") \
+      X(SELECTED,               "selected") \
+      X(SIZE_SPATIUM_DEPENDENT, "sizeIsSpatiumDependent") \
+      X(SMALL,                  "small") \
+      X(SPANNER,                "Spanner") \
+      X(STAFF_MOVE,             "staffMove") \
+      X(STEM,                   "Stem") \
+      X(STEM_DIRECTION,         "StemDirection") \
+      X(STEM_SLASH,             "StemSlash") \
+      X(STRING,                 "string") \
+      X(SYMBOL,                 "Symbol") \
+      X(TAG,                    "tag") \
+      X(TICK,                   "tick") \
+      X(TICK_OFFSET,            "tickOffset") \
+      X(TICKLEN,                "ticklen") \
+      X(TPC,                    "tpc") \
+      X(TPC2,                   "tpc2") \
+      X(TRACK,                  "track") \
+      X(TRAILING_SPACE,         "trailingSpace") \
+      X(TREMOLO,                "Tremolo") \
+      X(TUNING,                 "tuning") \
+      X(VELO_TYPE,              "veloType") \
+      X(VELOCITY,               "velocity") \
+      X(VISIBLE,                "visible") \
+      X(VOICE,                  "voice") \
+      X(Z,                      "z")
+
+enum class XmlTag : unsigned char {
+      UNKNOWN,
+#define X(id, name) id,
+      XML_TAGS(X)
+#undef X
+      TAGS
+      };
+
+extern XmlTag xmlTag(const QStringRef&);
+
 //---------------------------------------------------------
 //   XmlReader
 //---------------------------------------------------------
@@ -101,6 +192,9 @@ class XmlReader : public QXmlStreamReader {
 
       QList<TextStyleMap> userTextStyles;
 
+      mutable qint64 _tagOffset { -1 };      // character offset of the element _tagId was computed for
+      mutable XmlTag _tagId     { XmlTag::UNKNOWN };
+
       void addConnectorInfo(std::unique_ptr<ConnectorInfoReader>);
       void removeConnector(const ConnectorInfoReader*); // Removes the whole ConnectorInfo chain from the connectors list.
 
@@ -113,8 +207,17 @@ class XmlReader : public QXmlStreamReader {
       XmlReader& operator=(const XmlReader&) = delete;
       ~XmlReader();
 
+      // hide the QXmlStreamReader versions, character offsets
+      // restart or shift with new input
+      void clear()                        { QXmlStreamReader::clear();        _tagOffset = -1; }
+      void addData(const QByteArray& d)   { QXmlStreamReader::addData(d);     _tagOffset = -1; }
+      void addData(const QString& d)      { QXmlStreamReader::addData(d);     _tagOffset = -1; }
+      void addData(const char* d)         { QXmlStreamReader::addData(d);     _tagOffset = -1; }
+      void setDevice(QIODevice* d)        { QXmlStreamReader::setDevice(d);   _tagOffset = -1; }
+
       bool hasAccidental;                     // used for userAccidental backward compatibility
       void unknown();
+      XmlTag tagId() const;
 
       // attribute helper routines:
       QString attribute(const char* s) const { return attributes().value(s).toString(); }
@@ -240,6 +343,8 @@ class XmlWriter : public QTextStream {
       bool _recordElements = false;
 
       void putLevel();
+      void putInt(qint64);
+      void newLine();
 
    public:
       XmlWriter(Score*);
@@ -277,7 +382,7 @@ class XmlWriter : public QTextStream {
       const std::vector<std::pair<const ScoreElement*, QString>>& elements() const { return _elements; }
       void setRecordElements(bool record) { _recordElements = record; }
 
-      void sTag(const char* name, Spatium sp) { XmlWriter::tag(name, QVariant(sp.val())); }
+      void sTag(const char* name, Spatium sp) { XmlWriter::tag(name, sp.val()); }
       void pTag(const char* name, PlaceText);
 
       void header();
@@ -297,8 +402,13 @@ class XmlWriter : public QTextStream {
       void tag(Pid id, QVariant data, QVariant defaultData = QVariant());
       void tag(const char* name, QVariant data, QVariant defaultData = QVariant());
       void tag(const QString&, QVariant data);
-      void tag(const char* name, const char* s)    { tag(name, QVariant(s)); }
-      void tag(const char* name, const QString& s) { tag(name, QVariant(s)); }
+      void tag(const char* name, int);
+      void tag(const char* name, unsigned);
+      void tag(const char* name, qint64);
+      void tag(const char* name, double);
+      void tag(const char* name, const Fraction&);
+      void tag(const char* name, const char* s);
+      void tag(const char* name, const QString& s);
       void tag(const char* name, const QWidget*);
 
       void comment(const QString&);
@@ -218,6 +218,81 @@ void XmlReader::unknown()
       skipCurrentElement();
       }
 
+//---------------------------------------------------------
+//   xmlTagNames
+//---------------------------------------------------------
+
+static const char* xmlTagNames[] = {
+      "",
+#define X(id, name) name,
+      XML_TAGS(X)
+#undef X
+      };
+
+//---------------------------------------------------------
+//   XmlTagTable
+//    open addressing hash table over xmlTagNames, built
+//    once; with less than a quarter of the slots used
+//    almost every lookup is a single string compare
+//---------------------------------------------------------
+
+struct XmlTagTable {
+      static const int SIZE = 512;
+      unsigned char slot[SIZE];           // XmlTag, UNKNOWN for an empty slot
+
+      static uint hash(const QChar* s, int n)
+            {
+            uint h = 2166136261u;         // FNV-1a
+            for (int i = 0; i < n; ++i)
+                  h = (h ^ s[i].unicode()) * 16777619u;
+            return h & (SIZE - 1);
+            }
+
+      XmlTagTable()
+            {
+            static_assert(int(XmlTag::TAGS) < SIZE / 4, "XmlTagTable too small");
+            memset(slot, 0, sizeof(slot));
+            for (int i = 1; i < int(XmlTag::TAGS); ++i) {
+                  QString name(QLatin1String(xmlTagNames[i]));
+                  uint k = hash(name.unicode(), name.size());
+                  while (slot[k])
+                        k = (k + 1) & (SIZE - 1);
+                  slot[k] = i;
+                  }
+            }
+      };
+
+//---------------------------------------------------------
+//   xmlTag
+//---------------------------------------------------------
+
+XmlTag xmlTag(const QStringRef& s)
+      {
+      static const XmlTagTable table;
+      for (uint k = XmlTagTable::hash(s.unicode(), s.size()); table.slot[k]; k = (k + 1) & (XmlTagTable::SIZE - 1)) {
+            int i = table.slot[k];
+            if (s == QLatin1String(xmlTagNames[i]))
+                  return XmlTag(i);
+            }
+      return XmlTag::UNKNOWN;
+      }
+
+//---------------------------------------------------------
+//   tagId
+//    XmlTag of the current element, looked up once per
+//    element even if several readProperties() levels ask
+//---------------------------------------------------------
+
+XmlTag XmlReader::tagId() const
+      {
+      qint64 offset = characterOffset();
+      if (offset != _tagOffset) {
+            _tagId     = xmlTag(name());
+            _tagOffset = offset;
+            }
+      return _tagId;
+      }
+
 //---------------------------------------------------------
 //   location
 //---------------------------------------------------------
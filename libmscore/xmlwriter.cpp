@@ -23,6 +23,22 @@
 
 namespace Ms {
 
+//---------------------------------------------------------
+//   tagName
+//    element name without attributes
+//---------------------------------------------------------
+
+static inline QLatin1String tagName(const char* name)
+      {
+      const char* p = strchr(name, ' ');
+      return QLatin1String(name, p ? int(p - name) : int(strlen(name)));
+      }
+
+static inline QStringRef tagName(const QString& name)
+      {
+      return name.leftRef(name.indexOf(' '));
+      }
+
 //---------------------------------------------------------
 //   Xml
 //---------------------------------------------------------
@@ -58,9 +74,45 @@ void XmlWriter::pTag(const char* name, PlaceText place)
 
 void XmlWriter::putLevel()
       {
-      int level = stack.size();
-      for (int i = 0; i < level * 2; ++i)
-            *this << ' ';
+      static const char spaces[] = "                                                                ";
+      const int n = int(sizeof(spaces)) - 1;
+      int indent  = stack.size() * 2;
+      for (; indent > n; indent -= n)
+            *this << QLatin1String(spaces, n);
+      *this << QLatin1String(spaces, indent);
+      }
+
+//---------------------------------------------------------
+//   newLine
+//    end the current line; the stream is flushed when the
+//    outermost element is closed, so that the device is
+//    complete as soon as the document is
+//---------------------------------------------------------
+
+void XmlWriter::newLine()
+      {
+      *this << '\n';
+      if (stack.isEmpty())
+            flush();
+      }
+
+//---------------------------------------------------------
+//   putInt
+//    format without going through QLocale
+//---------------------------------------------------------
+
+void XmlWriter::putInt(qint64 val)
+      {
+      char buffer[24];
+      char* p = buffer + sizeof(buffer);
+      quint64 v = val < 0 ? quint64(0) - quint64(val) : quint64(val);
+      do {
+            *--p = char('0' + v % 10);
+            v /= 10;
+            } while (v);
+      if (val < 0)
+            *--p = '-';
+      *this << QLatin1String(p, int(buffer + sizeof(buffer) - p));
       }
 
 //---------------------------------------------------------
@@ -80,8 +132,9 @@ void XmlWriter::header()
 void XmlWriter::stag(const QString& s)
       {
       putLevel();
-      *this << '<' << s << '>' << endl;
-      stack.append(s.split(' ')[0]);
+      *this << '<' << s << '>';
+      newLine();
+      stack.append(tagName(s).toString());
       }
 
 //---------------------------------------------------------
@@ -105,7 +158,8 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
       *this << '<' << name;
       if (!attributes.isEmpty())
             *this << ' ' << attributes;
-      *this << '>' << endl;
+      *this << '>';
+      newLine();
       stack.append(name);
 
       if (_recordElements)
@@ -120,7 +174,8 @@ void XmlWriter::stag(const QString& name, const ScoreElement* se, const QString&
 void XmlWriter::etag()
       {
       putLevel();
-      *this << "</" << stack.takeLast() << '>' << endl;
+      *this << "</" << stack.takeLast() << '>';
+      newLine();
       }
 
 //---------------------------------------------------------
@@ -138,7 +193,8 @@ void XmlWriter::tagE(const char* format, ...)
       vsnprintf(buffer, BS, format, args);
       *this << buffer;
       va_end(args);
-      *this << "/>" << endl;
+      *this << "/>";
+      newLine();
       }
 
 //---------------------------------------------------------
@@ -169,7 +225,8 @@ void XmlWriter::ntag(const char* name)
 
 void XmlWriter::netag(const char* s)
       {
-      *this << "</" << s << '>' << endl;
+      *this << "</" << s << '>';
+      newLine();
       }
 
 //---------------------------------------------------------
@@ -188,7 +245,7 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
       if (writableVal.isEmpty())
             tag(name, data);
       else
-            tag(name, QVariant(writableVal));
+            tag(name, writableVal);
       }
 
 //---------------------------------------------------------
@@ -198,13 +255,88 @@ void XmlWriter::tag(Pid id, QVariant data, QVariant defaultData)
 
 void XmlWriter::tag(const char* name, QVariant data, QVariant defaultData)
       {
-      if (data != defaultData)
-            tag(QString(name), data);
+      if (data == defaultData)
+            return;
+      // common types are written directly, the rest goes through
+      // the generic QString variant
+      switch (data.type()) {
+            case QVariant::Bool:
+            case QVariant::Char:
+            case QVariant::Int:
+            case QVariant::UInt:
+                  tag(name, data.toInt());
+                  break;
+            case QVariant::LongLong:
+                  tag(name, data.toLongLong());
+                  break;
+            case QVariant::Double:
+                  tag(name, data.value<double>());
+                  break;
+            case QVariant::String:
+                  tag(name, data.value<QString>());
+                  break;
+            default:
+                  tag(QString(name), data);
+                  break;
+            }
+      }
+
+//---------------------------------------------------------
+//   tag
+//    typed versions, no QVariant boxing
+//---------------------------------------------------------
+
+void XmlWriter::tag(const char* name, int val)
+      {
+      putLevel();
+      *this << '<' << name << '>';
+      putInt(val);
+      *this << "</" << tagName(name) << ">\n";
+      }
+
+void XmlWriter::tag(const char* name, unsigned val)
+      {
+      tag(name, int(val));
+      }
+
+void XmlWriter::tag(const char* name, qint64 val)
+      {
+      putLevel();
+      *this << '<' << name << '>';
+      putInt(val);
+      *this << "</" << tagName(name) << ">\n";
+      }
+
+void XmlWriter::tag(const char* name, double val)
+      {
+      putLevel();
+      *this << '<' << name << '>' << val << "</" << tagName(name) << ">\n";
+      }
+
+void XmlWriter::tag(const char* name, const Fraction& val)
+      {
+      putLevel();
+      *this << '<' << name << '>';
+      putInt(val.numerator());
+      *this << '/';
+      putInt(val.denominator());
+      *this << "</" << tagName(name) << ">\n";
+      }
+
+void XmlWriter::tag(const char* name, const char* s)
+      {
+      tag(name, QString::fromUtf8(s));
+      }
+
+void XmlWriter::tag(const char* name, const QString& s)
+      {
+      putLevel();
+      *this << '<' << name << '>' << xmlString(s) << "</" << tagName(name) << ">\n";
       }
 
 void XmlWriter::tag(const QString& name, QVariant data)
       {
-      QString ename(name.split(' ')[0]);
+      QStringRef ename(tagName(name));
 
       putLevel();
       switch(data.type()) {
@@ -316,7 +448,8 @@ void XmlWriter::tag(const char* name, const QWidget* g)
 void XmlWriter::comment(const QString& text)
       {
       putLevel();
-      *this << "<!-- " << text << " -->" << endl;
+      *this << "<!-- " << text << " -->";
+      newLine();
       }
 
 //---------------------------------------------------------
@@ -391,7 +524,7 @@ void XmlWriter::dump(int len, const unsigned char* p)
 
 void XmlWriter::writeXml(const QString& name, QString s)
       {
-      QString ename(name.split(' ')[0]);
+      QStringRef ename(tagName(name));
       putLevel();
       for (int i = 0; i < s.size(); ++i) {
             ushort c = s.at(i).unicode();
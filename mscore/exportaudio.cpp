@@ -71,6 +71,7 @@ bool MuseScore::saveAudio(Score* score, QIODevice *device, std::function<bool(fl
           if (!r)
                 synth->init();
           }
+    synth->setOffline(true);
 
     int oldSampleRate  = MScore::sampleRate;
     MScore::sampleRate = sampleRate;
@@ -279,6 +280,7 @@ bool MuseScore::saveAudio(Score* score, const QString& name)
       bool r = synth->setState(score->synthesizerState());
       if (!r)
           synth->init();
+      synth->setOffline(true);
 
       int oldSampleRate  = MScore::sampleRate;
       MScore::sampleRate = sampleRate;
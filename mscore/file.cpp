@@ -2558,6 +2558,132 @@ static QRect trim(QImage source, int margin)
       }
 #endif
 
+//---------------------------------------------------------
+//   PngPage
+//    a page to export; the elements and the rectangle to
+//    render are collected on the calling thread
+//---------------------------------------------------------
+
+struct PngPage {
+      int pageNumber     { 0 };
+      QIODevice* device  { 0 };     // if null the page is written to fileName
+      QString fileName;
+      QList<Element*> elements;
+      QRectF rect;
+      bool ok            { false };
+
+      PngPage() {}
+      PngPage(int n, QIODevice* d) : pageNumber(n), device(d) {}
+      PngPage(int n, const QString& fn) : pageNumber(n), fileName(fn) {}
+      };
+
+//---------------------------------------------------------
+//   renderPngPage
+//    Rasterize one page. This is called concurrently for
+//    the pages of a score and only draws the elements;
+//    MScore::pixelRatio and the printing flag are set up
+//    by the caller.
+//---------------------------------------------------------
+
+static QImage renderPngPage(PngPage& pp, double convDpi, bool transparent, bool trim, QImage::Format format)
+      {
+      QImage::Format f;
+      if (format != QImage::Format_Indexed8)
+          f = format;
+      else
+          f = QImage::Format_ARGB32_Premultiplied;
+
+      const QRectF& r = pp.rect;
+      int w = lrint(r.width()  * convDpi / DPI);
+      int h = lrint(r.height() * convDpi / DPI);
+
+      QImage printer(w, h, f);
+      printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
+      printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
+
+      printer.fill(transparent ? 0 : 0xffffffff);
+      double mag_ = convDpi / DPI;
+
+      QPainter p(&printer);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(mag_, mag_);
+      if (trim)
+            p.translate(-r.topLeft());
+      qStableSort(pp.elements.begin(), pp.elements.end(), elementLessThan);
+      paintElements(p, pp.elements);
+      p.end();
+      if (format == QImage::Format_Indexed8) {
+            //convert to grayscale & respect alpha
+            QVector<QRgb> colorTable;
+            colorTable.push_back(QColor(0, 0, 0, 0).rgba());
+            if (!transparent) {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(i, i, i).rgb());
+                  }
+            else {
+                  for (int i = 1; i < 256; i++)
+                        colorTable.push_back(QColor(0, 0, 0, i).rgba());
+                  }
+            printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
+            }
+      return printer;
+      }
+
+//---------------------------------------------------------
+//   savePngPages
+//    Rasterize and encode the given pages on the global
+//    thread pool. Every worker holds one page image at a
+//    time, so memory is bounded by the number of threads.
+//    return true on success
+//---------------------------------------------------------
+
+static bool savePngPages(Score* score, QVector<PngPage>& pages)
+      {
+      const bool screenshot = false;
+      const bool transparent = preferences.getBool(PREF_EXPORT_PNG_USETRANSPARENCY);
+      const double convDpi = preferences.getDouble(PREF_EXPORT_PNG_RESOLUTION);
+      const int localTrimMargin = trimMargin;
+      const QImage::Format format = QImage::Format_ARGB32_Premultiplied;
+
+      score->setPrinting(!screenshot);    // don’t print page break symbols etc.
+      double pr = MScore::pixelRatio;
+      MScore::pixelRatio = DPI / convDpi;
+
+      // collecting the elements may update caches of the score,
+      // do it before going parallel
+      const QList<Page*>& pl = score->pages();
+      for (PngPage& pp : pages) {
+            Page* page = pl.at(pp.pageNumber);
+            pp.elements = page->elements();
+            if (localTrimMargin >= 0) {
+                  QMarginsF margins(localTrimMargin, localTrimMargin, localTrimMargin, localTrimMargin);
+                  pp.rect = page->tbbox() + margins;
+                  }
+            else
+                  pp.rect = page->abbox();
+            }
+
+      const bool trim = localTrimMargin >= 0;
+      auto render = [convDpi, transparent, trim, format](PngPage& pp) {
+            QImage image = renderPngPage(pp, convDpi, transparent, trim, format);
+            pp.ok = pp.device ? image.save(pp.device, "png") : image.save(pp.fileName, "png");
+            };
+      if (pages.size() == 1)
+            render(pages[0]);
+      else
+            QtConcurrent::blockingMap(pages, render);
+
+      score->setPrinting(false);
+      MScore::pixelRatio = pr;
+
+      for (const PngPage& pp : pages) {
+            if (!pp.ok)
+                  return false;
+            }
+      return true;
+      }
+
 //---------------------------------------------------------
 //   savePng
 //    return true on success.  Works with editor, shows additional windows.
@@ -2570,6 +2696,7 @@ bool MuseScore::savePng(Score* score, const QString& name)
       int padding = QString("%1").arg(pages).size();
       bool overwrite = false;
       bool noToAll = false;
+      QVector<PngPage> pngPages;
       for (int pageNumber = 0; pageNumber < pages; ++pageNumber) {
             QString fileName(name);
             if (fileName.endsWith(".png"))
@@ -2599,14 +2726,10 @@ bool MuseScore::savePng(Score* score, const QString& name)
                               continue;
                         }
                   }
-            QFile f(fileName);
-            if (!f.open(QIODevice::WriteOnly))
-                  return false;
-            bool rv = savePng(score, &f, pageNumber);
-            if (!rv)
-                  return false;
+            pngPages.append(PngPage(pageNumber, fileName));
             }
-      return true;
+      // the questions are asked first, the pages are then rendered in parallel
+      return savePngPages(score, pngPages);
       }
 
 //---------------------------------------------------------
@@ -2616,70 +2739,30 @@ bool MuseScore::savePng(Score* score, const QString& name)
 
 bool MuseScore::savePng(Score* score, QIODevice* device, int pageNumber)
       {
-      const bool screenshot = false;
-      const bool transparent = preferences.getBool(PREF_EXPORT_PNG_USETRANSPARENCY);
-      const double convDpi = preferences.getDouble(PREF_EXPORT_PNG_RESOLUTION);
-      const int localTrimMargin = trimMargin;
-      const QImage::Format format = QImage::Format_ARGB32_Premultiplied;
-
-      bool rv = true;
-      score->setPrinting(!screenshot);    // don’t print page break symbols etc.
-      double pr = MScore::pixelRatio;
-
-      QImage::Format f;
-      if (format != QImage::Format_Indexed8)
-          f = format;
-      else
-          f = QImage::Format_ARGB32_Premultiplied;
-
-      const QList<Page*>& pl = score->pages();
-
-      Page* page = pl.at(pageNumber);
-      QRectF r;
-      if (localTrimMargin >= 0) {
-            QMarginsF margins(localTrimMargin, localTrimMargin, localTrimMargin, localTrimMargin);
-            r = page->tbbox() + margins;
-            }
-      else
-            r = page->abbox();
-      int w = lrint(r.width()  * convDpi / DPI);
-      int h = lrint(r.height() * convDpi / DPI);
-
-      QImage printer(w, h, f);
-      printer.setDotsPerMeterX(lrint((convDpi * 1000) / INCH));
-      printer.setDotsPerMeterY(lrint((convDpi * 1000) / INCH));
+      QVector<PngPage> pngPages { PngPage(pageNumber, device) };
+      return savePngPages(score, pngPages);
+      }
 
-      printer.fill(transparent ? 0 : 0xffffffff);
-      double mag_ = convDpi / DPI;
-      MScore::pixelRatio = 1.0 / mag_;
+//---------------------------------------------------------
+//   savePng
+//    render all pages of the score to png data,
+//    return true on success
+//---------------------------------------------------------
 
-      QPainter p(&printer);
-      p.setRenderHint(QPainter::Antialiasing, true);
-      p.setRenderHint(QPainter::TextAntialiasing, true);
-      p.scale(mag_, mag_);
-      if (localTrimMargin >= 0)
-            p.translate(-r.topLeft());
-      QList< Element*> pel = page->elements();
-      qStableSort(pel.begin(), pel.end(), elementLessThan);
-      paintElements(p, pel);
-       if (format == QImage::Format_Indexed8) {
-            //convert to grayscale & respect alpha
-            QVector<QRgb> colorTable;
-            colorTable.push_back(QColor(0, 0, 0, 0).rgba());
-            if (!transparent) {
-                  for (int i = 1; i < 256; i++)
-                        colorTable.push_back(QColor(i, i, i).rgb());
-                  }
-            else {
-                  for (int i = 1; i < 256; i++)
-                        colorTable.push_back(QColor(0, 0, 0, i).rgba());
-                  }
-            printer = printer.convertToFormat(QImage::Format_Indexed8, colorTable);
+bool MuseScore::savePng(Score* score, QList<QByteArray>& pngData)
+      {
+      int pages = score->pages().size();
+      pngData.clear();
+      for (int i = 0; i < pages; ++i)
+            pngData.append(QByteArray());
+      std::vector<std::unique_ptr<QBuffer>> buffers;
+      QVector<PngPage> pngPages;
+      for (int i = 0; i < pages; ++i) {
+            buffers.emplace_back(new QBuffer(&pngData[i]));
+            buffers.back()->open(QIODevice::ReadWrite);
+            pngPages.append(PngPage(i, buffers.back().get()));
             }
-      printer.save(device, "png");
-      score->setPrinting(false);
-      MScore::pixelRatio = pr;
-      return rv;
+      return savePngPages(score, pngPages);
       }
 
 //---------------------------------------------------------
@@ -3303,13 +3386,11 @@ bool MuseScore::exportAllMediaFiles(const QString& inFilePath, const QString& ou
       //export score pngs and svgs
       jsonWriter.addKey("pngs");
       jsonWriter.openArray();
-      for (int i = 0; i < score->pages().size(); ++i) {
-            QByteArray pngData;
-            QBuffer pngDevice(&pngData);
-            pngDevice.open(QIODevice::ReadWrite);
-            res &= mscore->savePng(score.get(), &pngDevice, i);
-            bool lastArrayValue = ((score->pages().size() - 1) == i);
-            jsonWriter.addValue(pngData.toBase64(), lastArrayValue);
+      QList<QByteArray> pngs;
+      res &= mscore->savePng(score.get(), pngs);
+      for (int i = 0; i < pngs.size(); ++i) {
+            bool lastArrayValue = ((pngs.size() - 1) == i);
+            jsonWriter.addValue(pngs[i].toBase64(), lastArrayValue);
             }
       jsonWriter.closeArray();
 
@@ -210,22 +210,24 @@ void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
       {
       auto &opers = midiImportOperations;
 
-      for (auto &track: tracks) {
-            MTrack &mtrack = track.second;
-            if (mtrack.chords.empty())
-                  continue;
-                        // pass current track index through MidiImportOperations
-                        // for further usage
-            MidiOperations::CurrentTrackSetter setCurrentTrack{opers, mtrack.indexOfOperation};
-
-            if (opers.data()->processingsOfOpenedFile == 0) {
+                  // operations are only read below, so set them up front
+      if (opers.data()->processingsOfOpenedFile == 0) {
+            for (const auto &track: tracks) {
+                  const MTrack &mtrack = track.second;
+                  if (mtrack.chords.empty())
+                        continue;
                   opers.data()->trackOpers.isDrumTrack.setValue(
-                                          opers.currentTrack(), mtrack.mtrack->drumTrack());
+                                          mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
                   if (mtrack.mtrack->drumTrack()) {
                         opers.data()->trackOpers.maxVoiceCount.setValue(
-                                          opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                                          mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
                         }
                   }
+            }
+
+      MidiOperations::forEachTrack(tracks, [&opers, sigmap, &lastTick](MTrack &mtrack) {
+            if (mtrack.chords.empty())
+                  return;
             const auto basicQuant = Quantize::quantValueToFraction(
                         opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
 
@@ -239,7 +241,7 @@ void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
             else
                   MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
 
-            Q_ASSERT_X(!doNotesOverlap(track.second),
+            Q_ASSERT_X(!doNotesOverlap(mtrack),
                        "quantizeAllTracks",
                        "There are overlapping notes of the same voice that is incorrect");
 
@@ -252,7 +254,7 @@ void quantizeAllTracks(std::multimap<int, MTrack> &tracks,
             Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
                        "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
                         "or non-tuplet chord/note is inside tuplet");
-            }
+            });
       }
 
 //---------------------------------------------------------
@@ -982,7 +984,7 @@ void processLyricMeta(QList<MTrack> &tracks)
 
 void createKeys(QList<MTrack> &tracks)
       {
-      const Key defaultKey = Key::C;     // TODO-LIB findKey(mtrack, score->sigmap());
+      const Key defaultKey = Key::C;     // main key is found by MidiKey::recognizeMainKeySig
       const KeyList &allKeyList = findAllKeyList(tracks);
 
       for (int i = 0; i < tracks.size(); ++i) {
@@ -205,6 +205,26 @@ MidiOperations::TimeSigDenominator fractionDenominatorToUserValue(int z)
 
 } // namespace Meter
 
+namespace MidiOperations {
+
+void forEachTrack(std::multimap<int, MTrack> &tracks,
+                  const std::function<void(MTrack &)> &func)
+      {
+      std::vector<MTrack *> trackList;
+      for (auto &track: tracks)
+            trackList.push_back(&track.second);
+
+      auto &opers = midiImportOperations;
+      QtConcurrent::blockingMap(trackList, [&opers, &func](MTrack *mtrack) {
+                        // pass current track index through MidiImportOperations
+                        // for further usage
+            CurrentTrackSetter setCurrentTrack{opers, mtrack->indexOfOperation};
+            func(*mtrack);
+            });
+      }
+
+} // namespace MidiOperations
+
 namespace MidiTuplet {
 
 bool haveIntersection(const std::pair<ReducedFraction, ReducedFraction> &interval1,
@@ -9,6 +9,7 @@
 #include <vector>
 #include <cstddef>
 #include <utility>
+#include <functional>
 
 // ---------------------------------------------------------------------------------------
 // These inner classes definitions are used in cpp files only
@@ -106,6 +107,15 @@ class MTrack {
       void updateTuplet(std::multimap<ReducedFraction, MidiTuplet::TupletData>::iterator &);
       };
 
+namespace MidiOperations {
+
+// call func for every track with the track's operations index set as the current track;
+// tracks are independent at this stage, so they are processed on the thread pool
+void forEachTrack(std::multimap<int, MTrack> &tracks,
+                  const std::function<void(MTrack &)> &func);
+
+} // namespace MidiOperations
+
 namespace MidiTuplet {
 
 struct TupletInfo
@@ -231,7 +231,8 @@ class Data
 
       QString _currentMidiFile;
       QString _midiOperationsFile;
-      int _currentTrack = -1;
+                  // per thread, so that tracks can be processed concurrently
+      static thread_local int _currentTrack;
 
       std::map<QString, FileData> _data;    // <file name, tracks data>
       };
@@ -280,17 +280,14 @@ void simplifyDurations(
       {
       auto &opers = midiImportOperations;
 
-      for (auto &track: tracks) {
-            MTrack &mtrack = track.second;
+      MidiOperations::forEachTrack(tracks, [&opers, sigmap, simplifyDrumTracks](MTrack &mtrack) {
             if (mtrack.mtrack->drumTrack() != simplifyDrumTracks)
-                  continue;
-            auto &chords = track.second.chords;
+                  return;
+            auto &chords = mtrack.chords;
             if (chords.empty())
-                  continue;
+                  return;
 
             if (opers.data()->trackOpers.simplifyDurations.value(mtrack.indexOfOperation)) {
-                  MidiOperations::CurrentTrackSetter setCurrentTrack{opers, mtrack.indexOfOperation};
-
                   Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
                              "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
                              "or non-tuplet chord/note is inside tuplet before simplification");
@@ -303,7 +300,7 @@ void simplifyDurations(
                              "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
                              "or non-tuplet chord/note is inside tuplet after simplification");
                   }
-            }
+            });
       }
 
 void simplifyDurationsForDrums(std::multimap<int, MTrack> &tracks, const TimeSigMap *sigmap)
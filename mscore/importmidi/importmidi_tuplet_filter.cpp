@@ -7,11 +7,16 @@
 #include "libmscore/mscore.h"
 
 #include <set>
+#include <functional>
 
 
 namespace Ms {
 namespace MidiTuplet {
 
+            // search over n tuplets visits at most 2^n selections,
+            // so this many tuplets are always searched exhaustively
+const size_t MAX_EXHAUSTIVE_TUPLETS = 17;         // found empirically
+
 bool isMoreTupletVoicesAllowed(int voicesInUse, int availableVoices)
       {
       return !(voicesInUse >= availableVoices || voicesInUse >= tupletVoiceLimit());
@@ -36,10 +41,7 @@ class TupletErrorResult
 
       bool operator<(const TupletErrorResult &er) const
             {
-            double value = div(tupletAverageError, er.tupletAverageError)
-                         - div(relativeUsedChordPlaces, er.relativeUsedChordPlaces)
-                         + div(sumLengthOfRests.numerator() * 1.0 / sumLengthOfRests.denominator(),
-                               er.sumLengthOfRests.numerator() * 1.0 / er.sumLengthOfRests.denominator());
+            double value = errorDifference(er);
             if (value == 0) {
                    value = div(voiceCount, er.voiceCount)
                          + div(tupletCount, er.tupletCount);
@@ -47,6 +49,15 @@ class TupletErrorResult
             return value < 0;
             }
 
+            // better regardless of the voice and tuplet counts;
+            // if er is an optimistic error of some selections (smaller error,
+            // more used chord places, shorter rests) then this one is better
+            // than all of them because the difference is monotone in each value
+      bool isClearlyBetter(const TupletErrorResult &er) const
+            {
+            return errorDifference(er) < 0;
+            }
+
    private:
       static double div(double val1, double val2)
             {
@@ -55,6 +66,14 @@ class TupletErrorResult
             return (val1 - val2) / qMax(val1, val2);
             }
 
+      double errorDifference(const TupletErrorResult &er) const
+            {
+            return div(tupletAverageError, er.tupletAverageError)
+                 - div(relativeUsedChordPlaces, er.relativeUsedChordPlaces)
+                 + div(sumLengthOfRests.numerator() * 1.0 / sumLengthOfRests.denominator(),
+                       er.sumLengthOfRests.numerator() * 1.0 / er.sumLengthOfRests.denominator());
+            }
+
       double tupletAverageError;
       double relativeUsedChordPlaces;
       ReducedFraction sumLengthOfRests;
@@ -529,6 +548,70 @@ class ValidTuplets
       };
 
 
+// optimistic error of all selections that contain selectedTuplets
+// and any of the valid tuplets: none of them can have a smaller error,
+// more used chord places or shorter rests
+
+TupletErrorResult findOptimisticTupletError(
+            const std::vector<int> &selectedTuplets,
+            const ValidTuplets &validTuplets,
+            const std::vector<TupletInfo> &tuplets,
+            size_t voiceCount,
+            const ReducedFraction &basicQuant)
+      {
+      ReducedFraction sumError{0, 1};
+      ReducedFraction sumLengthOfRests{0, 1};
+      size_t sumChordCount = 0;
+      int sumChordPlaces = 0;
+      std::set<std::pair<const ReducedFraction, MidiChord> *> usedChords;
+      std::vector<char> usedIndexes(tuplets.size(), 0);
+
+      for (int i: selectedTuplets) {
+            const auto &tuplet = tuplets[i];
+
+            sumError += tuplet.tupletSumError;
+            sumLengthOfRests += tuplet.sumLengthOfRests;
+            sumChordCount += tuplet.chords.size();
+            sumChordPlaces += tuplet.tupletNumber;
+
+            usedIndexes[i] = 1;
+            for (const auto &chord: tuplet.chords)
+                  usedChords.insert(&*chord.second);
+            }
+                  // added tuplets can't raise the share of used chord places
+                  // above the largest share of a single tuplet
+      double relativeUsedChordPlaces = sumChordCount * 1.0 / sumChordPlaces;
+      for (int i = validTuplets.first(); validTuplets.isValid(i); i = validTuplets.next(i)) {
+            const auto &tuplet = tuplets[i];
+
+            sumChordCount += tuplet.chords.size();
+            relativeUsedChordPlaces = qMax(relativeUsedChordPlaces,
+                                           tuplet.chords.size() * 1.0 / tuplet.tupletNumber);
+            usedIndexes[i] = 1;
+            for (const auto &chord: tuplet.chords)
+                  usedChords.insert(&*chord.second);
+            }
+                  // chords that no valid tuplet can take keep their quant error
+      for (size_t i = 0; i != tuplets.size(); ++i) {
+            if (usedIndexes[i])
+                  continue;
+            const auto &tuplet = tuplets[i];
+            for (const auto &chord: tuplet.chords) {
+                  if (usedChords.find(&*chord.second) != usedChords.end())
+                        continue;
+                  sumError += Quantize::findOnTimeQuantError(*chord.second, basicQuant);
+                  }
+            }
+
+      return TupletErrorResult{
+                  sumError.numerator() * 1.0 / (sumError.denominator() * sumChordCount),
+                  relativeUsedChordPlaces,
+                  sumLengthOfRests,
+                  voiceCount,
+                  selectedTuplets.size()
+            };
+      }
+
 void findNextTuplet(
             std::vector<int> &selectedTuplets,
             ValidTuplets &validTuplets,
@@ -538,9 +621,12 @@ void findNextTuplet(
             const std::vector<TupletInfo> &tuplets,
             const std::vector<std::pair<ReducedFraction, ReducedFraction> > &tupletIntervals,
             size_t commonsSize,
-            const ReducedFraction &basicQuant)
+            const ReducedFraction &basicQuant,
+            bool usePruning,
+            size_t &searchSteps)
       {
       while (!validTuplets.empty()) {
+            ++searchSteps;
             size_t index = validTuplets.first();
 
             bool isCommonGroupBegins = (selectedTuplets.empty() && index == commonsSize);
@@ -614,9 +700,14 @@ void findNextTuplet(
                                              selectedTuplets, tuplets, voiceIntervals, basicQuant);
                         }
                   }
-            else {
+                        // skip the selections that can't be better than the best one
+            else if (!usePruning || !minCurrentError.isInitialized()
+                        || !minCurrentError.isClearlyBetter(findOptimisticTupletError(
+                                    selectedTuplets, validTuplets, tuplets,
+                                    voiceIntervals.size(), basicQuant))) {
                   findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                                 tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                                 tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant,
+                                 usePruning, searchSteps);
                   }
 
             selectedTuplets.pop_back();
@@ -624,14 +715,18 @@ void findNextTuplet(
             }
       }
 
-void moveUncommonTupletsToEnd(std::vector<TupletInfo> &tuplets, std::set<int> &uncommons)
+void moveUncommonTupletsToEnd(std::vector<TupletInfo> &tuplets,
+                              std::set<int> &uncommons,
+                              std::vector<int> &tupletOrder)
       {
       int swapWith = int(tuplets.size()) - 1;
       for (int i = swapWith; i >= 0; --i) {
             auto it = uncommons.find(i);
             if (it != uncommons.end()) {
-                  if (i != swapWith)
+                  if (i != swapWith) {
                         std::swap(tuplets[i], tuplets[swapWith]);
+                        std::swap(tupletOrder[i], tupletOrder[swapWith]);
+                        }
                   --swapWith;
                   uncommons.erase(it);
                   }
@@ -641,96 +736,240 @@ void moveUncommonTupletsToEnd(std::vector<TupletInfo> &tuplets, std::set<int> &u
                  "Untested uncommon tuplets remaining");
       }
 
-std::vector<int> findBestTuplets(
+// take tuplets in the given order as long as they are compatible
+// with the ones taken before
+
+std::vector<int> findGreedyTuplets(
+            const std::vector<int> &order,
             const std::vector<TupletCommon> &tupletCommons,
             const std::vector<TupletInfo> &tuplets,
-            size_t commonsSize,
-            const ReducedFraction &basicQuant)
+            const std::vector<std::pair<ReducedFraction, ReducedFraction> > &tupletIntervals)
+      {
+      std::vector<int> selectedTuplets;
+      for (int i: order) {
+            if (isInCommonIndexes(i, selectedTuplets, tupletCommons))
+                  continue;
+            const auto voiceIntervals = prepareVoiceIntervals(selectedTuplets, tupletIntervals);
+            const auto usedFirstChords = prepareUsedFirstChords(selectedTuplets, tuplets);
+            if (!canUseIndex(i, tuplets, tupletIntervals, voiceIntervals, usedFirstChords))
+                  continue;
+            selectedTuplets.push_back(i);
+            }
+      std::sort(selectedTuplets.begin(), selectedTuplets.end());
+      return selectedTuplets;
+      }
+
+// search the best compatible subset of tuplets with the given indexes;
+// the search has to beat the initial selections (tuplet indexes);
+// returns tuplet indexes in the order of selection
+
+std::vector<int> searchBestTuplets(
+            const std::vector<TupletInfo> &tuplets,
+            std::vector<int> tupletOrder,
+            const std::vector<std::vector<int>> &initialSelections,
+            const ReducedFraction &basicQuant,
+            bool usePruning,
+            size_t &searchSteps)
       {
+      std::vector<TupletInfo> orderedTuplets;
+      for (int i: tupletOrder)
+            orderedTuplets.push_back(tuplets[i]);
+
+      std::set<int> uncommons = findLongestUncommonGroup(orderedTuplets, basicQuant);
+
+      Q_ASSERT_X(validateSelectedTuplets(uncommons.begin(), uncommons.end(), orderedTuplets),
+                 "MIDI tuplets: searchBestTuplets",
+                 "Uncommon tuplets have common chords but they shouldn't");
+
+      size_t commonsSize = orderedTuplets.size();
+      if (uncommons.size() > 1) {
+            commonsSize -= uncommons.size();
+            moveUncommonTupletsToEnd(orderedTuplets, uncommons, tupletOrder);
+            }
+      const auto tupletCommons = findTupletCommons(orderedTuplets);
+      const auto tupletIntervals = findTupletIntervals(orderedTuplets, basicQuant);
+
       std::vector<int> bestTupletIndexes;
       std::vector<int> selectedTuplets;
       TupletErrorResult minCurrentError;
-      const auto tupletIntervals = findTupletIntervals(tuplets, basicQuant);
 
-      ValidTuplets validTuplets(int(tuplets.size()));
+      std::vector<int> orderedIndexes(tuplets.size(), -1);
+      for (int i = 0; i != (int)tupletOrder.size(); ++i)
+            orderedIndexes[tupletOrder[i]] = i;
+      for (const auto &initialSelection: initialSelections) {
+            std::vector<int> selection;
+            for (int i: initialSelection) {
+                  Q_ASSERT_X(orderedIndexes[i] != -1, "MIDI tuplets: searchBestTuplets",
+                             "Initial selection has tuplets that are not searched");
+                  selection.push_back(orderedIndexes[i]);
+                  }
+            if (selection.empty())
+                  continue;
+            std::sort(selection.begin(), selection.end());
+            tryUpdateBestIndexes(bestTupletIndexes, minCurrentError, selection, orderedTuplets,
+                                 prepareVoiceIntervals(selection, tupletIntervals), basicQuant);
+            }
+
+      ValidTuplets validTuplets(int(orderedTuplets.size()));
 
       findNextTuplet(selectedTuplets, validTuplets, bestTupletIndexes, minCurrentError,
-                     tupletCommons, tuplets, tupletIntervals, commonsSize, basicQuant);
+                     tupletCommons, orderedTuplets, tupletIntervals, commonsSize, basicQuant,
+                     usePruning, searchSteps);
 
+      for (int &i: bestTupletIndexes)
+            i = tupletOrder[i];
       return bestTupletIndexes;
       }
 
-void removeExtraTuplets(std::vector<TupletInfo> &tuplets)
+TupletErrorResult findOwnTupletError(const TupletInfo &tuplet)
       {
-      const size_t MAX_TUPLETS = 17;         // found empirically
+      return TupletErrorResult{
+                  tuplet.tupletSumError.numerator() * 1.0
+                        / (tuplet.tupletSumError.denominator() * tuplet.chords.size()),
+                  tuplet.chords.size() * 1.0 / tuplet.tupletNumber,
+                  tuplet.sumLengthOfRests,
+                  1,
+                  1
+            };
+      }
 
-      if (tuplets.size() <= MAX_TUPLETS)
-            return;
+// tuplet indexes sorted by the own error of tuplets, the best tuplets first;
+// tuplets with equal errors keep their order
 
-      std::map<TupletErrorResult, size_t> errors;
-      for (size_t i = 0; i != tuplets.size(); ++i) {
-            auto tupletError = TupletErrorResult{
-                        tuplets[i].tupletSumError.numerator() * 1.0
-                              / (tuplets[i].tupletSumError.denominator() * tuplets[i].chords.size()),
-                        tuplets[i].chords.size() * 1.0 / tuplets[i].tupletNumber,
-                        tuplets[i].sumLengthOfRests,
-                        1,
-                        1
-                  };
-            errors.insert({tupletError, i});
-            }
-      std::vector<TupletInfo> newTuplets;
-      size_t count = 0;
-      for (const auto &e: errors) {
-            ++count;
-            newTuplets.push_back(tuplets[e.second]);
-            if (count == MAX_TUPLETS)
-                  break;
-            }
-
-      std::swap(tuplets, newTuplets);
+std::vector<int> sortTupletsByError(const std::vector<TupletInfo> &tuplets)
+      {
+      std::multimap<TupletErrorResult, int> errors;
+      for (int i = 0; i != (int)tuplets.size(); ++i)
+            errors.insert({findOwnTupletError(tuplets[i]), i});
+
+      std::vector<int> tupletOrder;
+      for (const auto &e: errors)
+            tupletOrder.push_back(e.second);
+      return tupletOrder;
       }
 
-// first chord in tuplet may belong to other tuplet at the same time
-// in the case if there are enough notes in this first chord
-// to be split into different voices
+// all combinations of the tuplets with the smallest own errors,
+// at most MAX_EXHAUSTIVE_TUPLETS of them; tuplets with equal errors
+// are taken only once
 
-void filterTuplets(std::vector<TupletInfo> &tuplets,
-                   const ReducedFraction &basicQuant)
+std::vector<int> findCappedBestTupletIndexes(
+            const std::vector<TupletInfo> &tuplets,
+            const ReducedFraction &basicQuant,
+            size_t &searchSteps)
       {
-      if (tuplets.empty())
-            return;
+      std::vector<int> tupletOrder;
+      if (tuplets.size() > MAX_EXHAUSTIVE_TUPLETS) {
+            std::map<TupletErrorResult, int> errors;
+            for (int i = 0; i != (int)tuplets.size(); ++i)
+                  errors.insert({findOwnTupletError(tuplets[i]), i});
+            for (const auto &e: errors) {
+                  tupletOrder.push_back(e.second);
+                  if (tupletOrder.size() == MAX_EXHAUSTIVE_TUPLETS)
+                        break;
+                  }
+            }
+      else {
+            tupletOrder.resize(tuplets.size());
+            for (int i = 0; i != (int)tupletOrder.size(); ++i)
+                  tupletOrder[i] = i;
+            }
+      return searchBestTuplets(tuplets, tupletOrder, {}, basicQuant, false, searchSteps);
+      }
 
-      Q_ASSERT_X(!areTupletChordsEmpty(tuplets),
-                 "MIDI tuplets: filterTuplets", "Tuplet has no chords but it should");
+bool isTupletSelectionBetter(
+            const std::vector<int> &tupletIndexes,
+            const std::vector<int> &otherTupletIndexes,
+            const std::vector<TupletInfo> &tuplets,
+            const ReducedFraction &basicQuant)
+      {
+      if (tupletIndexes.empty() || otherTupletIndexes.empty())
+            return !tupletIndexes.empty();
 
-      removeUselessTuplets(tuplets);
-      removeExtraTuplets(tuplets);
+      const auto tupletIntervals = findTupletIntervals(tuplets, basicQuant);
+      const auto error = findTupletError(
+                        tupletIndexes, tuplets,
+                        prepareVoiceIntervals(tupletIndexes, tupletIntervals).size(), basicQuant);
+      const auto otherError = findTupletError(
+                        otherTupletIndexes, tuplets,
+                        prepareVoiceIntervals(otherTupletIndexes, tupletIntervals).size(), basicQuant);
+      return error < otherError;
+      }
 
-      std::set<int> uncommons = findLongestUncommonGroup(tuplets, basicQuant);
+// up to MAX_EXHAUSTIVE_TUPLETS tuplets all combinations are tried;
+// for more tuplets the search over all of them starts from the capped
+// selection and the greedy one, and skips the selections that can't
+// beat the best selection found so far; the comparison of errors
+// is not transitive, so the capped selection is checked once more at the end
 
-      Q_ASSERT_X(validateSelectedTuplets(uncommons.begin(), uncommons.end(), tuplets),
-                 "MIDI tuplets: filterTuplets",
-                 "Uncommon tuplets have common chords but they shouldn't");
+std::vector<int> findBestTupletIndexes(
+            const std::vector<TupletInfo> &tuplets,
+            const ReducedFraction &basicQuant,
+            size_t &searchSteps)
+      {
+      const auto cappedIndexes = findCappedBestTupletIndexes(tuplets, basicQuant, searchSteps);
+      if (tuplets.size() <= MAX_EXHAUSTIVE_TUPLETS)
+            return cappedIndexes;
+
+      const auto tupletOrder = sortTupletsByError(tuplets);
+      const auto greedyIndexes = findGreedyTuplets(tupletOrder, findTupletCommons(tuplets), tuplets,
+                                                   findTupletIntervals(tuplets, basicQuant));
+      const auto bestIndexes = searchBestTuplets(tuplets, tupletOrder,
+                                                 {cappedIndexes, greedyIndexes},
+                                                 basicQuant, true, searchSteps);
+
+      if (isTupletSelectionBetter(cappedIndexes, bestIndexes, tuplets, basicQuant))
+            return cappedIndexes;
+      return bestIndexes;
+      }
 
-      size_t commonsSize = tuplets.size();
-      if (uncommons.size() > 1) {
-            commonsSize -= uncommons.size();
-            moveUncommonTupletsToEnd(tuplets, uncommons);
-            }
-      const auto tupletCommons = findTupletCommons(tuplets);
+static std::function<void(const std::vector<TupletInfo> &,
+                          const ReducedFraction &)> candidatesObserver;
+
+// for tests: the observer gets tuplet candidates of every bar before the selection
+
+void setTupletCandidatesObserver(
+            const std::function<void(const std::vector<TupletInfo> &, const ReducedFraction &)> &observer)
+      {
+      candidatesObserver = observer;
+      }
 
-      const std::vector<int> bestIndexes = findBestTuplets(tupletCommons, tuplets,
-                                                           commonsSize, basicQuant);
+// find the best compatible subset of tuplets;
+// returns the number of selections visited by the search
+
+size_t selectTuplets(std::vector<TupletInfo> &tuplets,
+                     const ReducedFraction &basicQuant)
+      {
+      removeUselessTuplets(tuplets);
+      if (candidatesObserver)
+            candidatesObserver(tuplets, basicQuant);
+
+      size_t searchSteps = 0;
+      const std::vector<int> bestIndexes = findBestTupletIndexes(tuplets, basicQuant, searchSteps);
 
       Q_ASSERT_X(validateSelectedTuplets(bestIndexes.begin(), bestIndexes.end(), tuplets),
-                 "MIDI tuplets: filterTuplets", "Tuplets have common chords but they shouldn't");
+                 "MIDI tuplets: selectTuplets", "Tuplets have common chords but they shouldn't");
 
-      std::vector<TupletInfo> newTuplets;
+      std::vector<TupletInfo> selectedTuplets;
       for (int i: bestIndexes)
-            newTuplets.push_back(tuplets[i]);
+            selectedTuplets.push_back(tuplets[i]);
+      std::swap(tuplets, selectedTuplets);
+      return searchSteps;
+      }
+
+// first chord in tuplet may belong to other tuplet at the same time
+// in the case if there are enough notes in this first chord
+// to be split into different voices
+
+void filterTuplets(std::vector<TupletInfo> &tuplets,
+                   const ReducedFraction &basicQuant)
+      {
+      if (tuplets.empty())
+            return;
+
+      Q_ASSERT_X(!areTupletChordsEmpty(tuplets),
+                 "MIDI tuplets: filterTuplets", "Tuplet has no chords but it should");
 
-      std::swap(tuplets, newTuplets);
+      selectTuplets(tuplets, basicQuant);
       }
 
 } // namespace MidiTuplet
@@ -14,6 +14,8 @@
 #include "network/loginmanager.h"
 #include "uploadscoredialog.h"
 #include <QStyleFactory>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include "palettebox.h"
 #include "config.h"
 #include "musescore.h"
@@ -188,6 +190,9 @@ QString mscoreGlobalShare;
 
 static QString outFileName;
 static QString jsonFileName;
+static bool jobReport { false };          // print a JSON report of the job entries
+static int jobWorkers { 1 };              // number of worker processes for a job
+static QString serverName;                // local socket name of the conversion server
 static QString audioDriver;
 static QString pluginName;
 static QString styleFile;
@@ -3461,16 +3466,7 @@ static bool doConvert(Score *cs, const QString& fn)
                   return mscore->savePdf(cs, fn);
             if (cs->excerpts().size() == 0) {
                   auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
-
-                  for (Excerpt* e : excerpts) {
-                        Score* nscore = new Score(e->oscore());
-                        e->setPartScore(nscore);
-                        nscore->style().set(Sid::createMultiMeasureRests, true);
-                        Excerpt::createExcerpt(e);
-                        cs->startCmd();
-                        cs->undo(new AddExcerpt(e));
-                        cs->endCmd();
-                        }
+                  Excerpt::createExcerpts(cs->masterScore(), excerpts, false);
                   }
             QList<Score*> scores;
             scores.append(cs);
@@ -3483,18 +3479,7 @@ static bool doConvert(Score *cs, const QString& fn)
                   return mscore->savePng(cs, fn);
             if (cs->excerpts().size() == 0) {
                   auto excerpts = Excerpt::createAllExcerpt(cs->masterScore());
-
-                  for (Excerpt* e: excerpts) {
-                        Score* nscore = new Score(e->oscore());
-                        e->setPartScore(nscore);
-                        nscore->setExcerpt(e);
-                        // nscore->setName(e->title()); // needed before AddExcerpt
-                        nscore->style().set(Sid::createMultiMeasureRests, true);
-                        Excerpt::createExcerpt(e);
-                        cs->startCmd();
-                        cs->undo(new AddExcerpt(e));
-                        cs->endCmd();
-                        }
+                  Excerpt::createExcerpts(cs->masterScore(), excerpts, false);
                   }
             if (!mscore->savePng(cs, fn))
                   return false;
@@ -3546,19 +3531,27 @@ static bool doConvert(Score *cs, const QString& fn)
 //   convert
 //---------------------------------------------------------
 
-static bool convert(const QString& inFile, const QJsonArray& outFiles, const QString& plugin = "")
+static bool convert(const QString& inFile, const QJsonArray& outFiles, const QString& plugin = "", QString* error = nullptr)
       {
       if (inFile.isEmpty() || (outFiles.isEmpty() && plugin.isEmpty())) {
             fprintf(stderr, "cannot convert <%s>: neither out nor plugin given\n", qPrintable(inFile));
+            if (error)
+                  *error = "neither out nor plugin given";
             return false;
             }
       fprintf(stderr, "convert <%s>...\n", qPrintable(inFile));
+      MScore::lastError.clear();
       MasterScore* score = mscore->readScore(inFile);
-      if (!score)
+      if (!score) {
+            if (error)
+                  *error = MScore::lastError.isEmpty() ? QString("cannot read <%1>").arg(inFile) : MScore::lastError;
             return false;
+            }
       mscore->setCurrentScore(score);
       bool success = doConvert(score, outFiles, plugin);
       fprintf(stderr, success ? "... success!\n" : "... failed!\n");
+      if (!success && error)
+            *error = MScore::lastError.isEmpty() ? QString("conversion failed") : MScore::lastError;
       mscore->setCurrentScore(nullptr);
       delete score;
       return success;
@@ -3569,6 +3562,166 @@ static bool convert(const QString& inFile, const QString& outFile)
       return convert(inFile, QJsonArray{ outFile });
       }
 
+//---------------------------------------------------------
+//   parseJobEntry
+//---------------------------------------------------------
+
+static bool parseJobEntry(const QJsonValue& job, QString& inFile, QJsonArray& outFiles, QString& plugin, QString& error)
+      {
+      if (!job.isObject()) {
+            fprintf(stderr, "array value is not an object\n");
+            error = "array value is not an object";
+            return false;
+            }
+      QJsonObject obj = job.toObject();
+      for (const auto& key : obj.keys()) {
+            if (key == "in")
+                  inFile = obj.value(key).toString();
+            else if (key == "out") {
+                  if (obj.value(key).isArray())
+                        outFiles = obj.value(key).toArray();
+                  else
+                        outFiles.push_back(obj.value(key));
+                  }
+            else if (key == "plugin")
+                  plugin = obj.value(key).toString();
+            else {
+                  fprintf(stderr, "unknown key <%s>\n", qPrintable(key));
+                  error = QString("unknown key <%1>").arg(key);
+                  return false;
+                  }
+            }
+      return true;
+      }
+
+//---------------------------------------------------------
+//   jobResult
+//    report entry for one job: the job itself, the result
+//    and the time spent in milliseconds
+//---------------------------------------------------------
+
+static QJsonObject jobResult(const QJsonValue& job, bool success, qint64 time, const QString& error)
+      {
+      QJsonObject result = job.isObject() ? job.toObject() : QJsonObject();
+      result["success"] = success;
+      result["time"]    = double(time);
+      if (!error.isEmpty())
+            result["error"] = error;
+      return result;
+      }
+
+//---------------------------------------------------------
+//   printJobReport
+//    written as one line to stdout, so that it can be told
+//    apart from other output
+//---------------------------------------------------------
+
+static void printJobReport(const QJsonArray& results, int workers, qint64 time)
+      {
+      bool success = true;
+      for (const QJsonValue& r : results)
+            success = success && r.toObject().value("success").toBool();
+      QJsonObject report;
+      report["success"] = success;
+      report["workers"] = workers;
+      report["time"]    = double(time);
+      report["jobs"]    = results;
+      fprintf(stdout, "%s\n", QJsonDocument(report).toJson(QJsonDocument::Compact).constData());
+      fflush(stdout);
+      }
+
+//---------------------------------------------------------
+//   jobWorkerArguments
+//    command line of this process without the job options
+//---------------------------------------------------------
+
+static QStringList jobWorkerArguments()
+      {
+      QStringList args = QCoreApplication::arguments();
+      args.removeFirst();
+      QStringList workerArgs;
+      for (int i = 0; i < args.size(); ++i) {
+            const QString& a = args[i];
+            if (a == "-j" || a == "--job" || a == "--jobs") {
+                  ++i;        // skip value
+                  continue;
+                  }
+            if (a.startsWith("--job=") || a.startsWith("--jobs=") || (a.startsWith("-j") && !a.startsWith("--")))
+                  continue;
+            workerArgs.append(a);
+            }
+      return workerArgs;
+      }
+
+//---------------------------------------------------------
+//   processJobParallel
+//    Score layout and export use global state (current
+//    score, printing flags, plugins, synthesizer), so jobs
+//    cannot run on threads of one process. Instead the
+//    entries are distributed over worker processes which
+//    each convert their share in one warm session.
+//---------------------------------------------------------
+
+static bool processJobParallel(const QJsonArray& jobs)
+      {
+      QElapsedTimer timer;
+      timer.start();
+
+      const int workers = qMin(jobWorkers, jobs.size());
+      // distribute round robin, neighbouring entries are often of similar size
+      QVector<QJsonArray> parts(workers);
+      QVector<QVector<int>> partIndexes(workers);
+      for (int i = 0; i < jobs.size(); ++i) {
+            parts[i % workers].append(jobs[i]);
+            partIndexes[i % workers].append(i);
+            }
+
+      const QStringList args = jobWorkerArguments();
+      std::vector<std::unique_ptr<QTemporaryFile>> files;
+      std::vector<std::unique_ptr<QProcess>> processes;
+      for (int w = 0; w < workers; ++w) {
+            files.emplace_back(new QTemporaryFile(QDir::tempPath() + "/mscore-job-XXXXXX.json"));
+            QTemporaryFile* f = files.back().get();
+            if (!f->open()) {
+                  fprintf(stderr, "cannot create job file <%s>\n", qPrintable(f->fileTemplate()));
+                  return false;
+                  }
+            f->write(QJsonDocument(parts[w]).toJson());
+            f->close();
+
+            processes.emplace_back(new QProcess);
+            QProcess* p = processes.back().get();
+            p->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+            p->start(QCoreApplication::applicationFilePath(), args + QStringList({ "-j", f->fileName(), "--jobs", "1" }));
+            }
+
+      QVector<QJsonValue> results(jobs.size());
+      for (int w = 0; w < workers; ++w) {
+            QProcess* p = processes[w].get();
+            p->waitForFinished(-1);
+            // the report is the last line of the worker output
+            QList<QByteArray> lines = p->readAllStandardOutput().trimmed().split('\n');
+            QJsonArray partResults = QJsonDocument::fromJson(lines.last()).object().value("jobs").toArray();
+            const bool crashed = p->exitStatus() != QProcess::NormalExit;
+            for (int k = 0; k < partIndexes[w].size(); ++k) {
+                  int i = partIndexes[w][k];
+                  if (!crashed && k < partResults.size())
+                        results[i] = partResults[k];
+                  else
+                        results[i] = jobResult(jobs[i], false, 0, QString("worker process failed: %1").arg(p->errorString()));
+                  }
+            }
+
+      QJsonArray report;
+      bool success = true;
+      for (const QJsonValue& r : results) {
+            report.append(r);
+            success = success && r.toObject().value("success").toBool();
+            }
+      printJobReport(report, workers, timer.elapsed());
+      return success;
+      }
+
 //---------------------------------------------------------
 //   doProcessJob
 //---------------------------------------------------------
@@ -3592,35 +3745,253 @@ static bool doProcessJob(QString jsonFile)
             return false;
             }
       QJsonArray a = doc.array();
+      if (jobWorkers > 1 && a.size() > 1)
+            return processJobParallel(a);
+
+      QElapsedTimer jobTimer;
+      jobTimer.start();
+      QJsonArray results;
+      bool success = true;
       for (const auto i : a) {
             QString inFile;
             QJsonArray outFiles;
             QString plugin;
-            if (!i.isObject()) {
-                  fprintf(stderr, "array value is not an object\n");
-                  return false;
+            QString error;
+            QElapsedTimer timer;
+            timer.start();
+            bool ok = parseJobEntry(i, inFile, outFiles, plugin, error)
+                      && convert(inFile, outFiles, plugin, &error);
+            if (!jobReport) {
+                  if (!ok)
+                        return false;
+                  continue;
                   }
-            QJsonObject obj = i.toObject();
-            for (const auto& key : obj.keys()) {
-                  if (key == "in")
-                        inFile = obj.value(key).toString();
-                  else if (key == "out") {
-                        if (obj.value(key).isArray())
-                              outFiles = obj.value(key).toArray();
+            // with a report, go on after errors and report them
+            results.append(jobResult(i, ok, timer.elapsed(), error));
+            success = success && ok;
+            }
+      if (jobReport)
+            printJobReport(results, 1, jobTimer.elapsed());
+      return success;
+      }
+
+//---------------------------------------------------------
+//   ConvertServer
+//    Serves conversion jobs over a local socket, all loaded
+//    fonts, templates and soundfonts stay resident between
+//    jobs. Requests and replies are JSON objects, one per line:
+//      {"id": 1, "in": "a.mscz", "out": ["a.pdf"], "plugin": "p.qml"}
+//            -> {"id": 1, "success": true, "time": 120}
+//      {"id": 2, "cancel": 1}  cancels queued job 1
+//      {"quit": true}          stops the server
+//    Jobs of all connections are queued and converted one
+//    after the other; run several servers to use more cores.
+//---------------------------------------------------------
+
+class ConvertServer {
+      struct Job {
+            QPointer<QLocalSocket> socket;
+            QJsonValue id;
+            QJsonObject job;
+            };
+
+      QLocalServer _server;
+      QList<Job> _queue;
+      QEventLoop _loop;
+      bool _running { false };
+      bool _quit    { false };
+
+      void newConnection();
+      void readRequests(QLocalSocket*);
+      void request(QLocalSocket*, const QJsonObject&);
+      void cancel(QLocalSocket*, const QJsonValue& id, const QJsonValue& jobId);
+      void runNext();
+      void scheduleNext();
+      static void reply(QLocalSocket*, const QJsonObject&);
+
+   public:
+      bool listen(const QString& name);
+      void exec() { _loop.exec(); }
+      };
+
+//---------------------------------------------------------
+//   listen
+//---------------------------------------------------------
+
+bool ConvertServer::listen(const QString& name)
+      {
+      QLocalSocket probe;
+      probe.connectToServer(name);
+      if (probe.waitForConnected(500)) {
+            fprintf(stderr, "a conversion server is already listening on <%s>\n", qPrintable(name));
+            return false;
+            }
+      QLocalServer::removeServer(name);       // nobody answered: remove a stale socket of a crashed server
+      _server.setSocketOptions(QLocalServer::UserAccessOption);
+      if (!_server.listen(name)) {
+            fprintf(stderr, "cannot listen on <%s>: %s\n", qPrintable(name), qPrintable(_server.errorString()));
+            return false;
+            }
+      QObject::connect(&_server, &QLocalServer::newConnection, [this]() { newConnection(); });
+      fprintf(stderr, "conversion server listening on <%s>\n", qPrintable(_server.fullServerName()));
+      return true;
+      }
+
+//---------------------------------------------------------
+//   newConnection
+//---------------------------------------------------------
+
+void ConvertServer::newConnection()
+      {
+      while (QLocalSocket* socket = _server.nextPendingConnection()) {
+            QObject::connect(socket, &QLocalSocket::readyRead, [this, socket]() { readRequests(socket); });
+            QObject::connect(socket, &QLocalSocket::disconnected, [this, socket]() {
+                  // drop queued jobs nobody waits for
+                  for (auto i = _queue.begin(); i != _queue.end();) {
+                        if (i->socket == socket)
+                              i = _queue.erase(i);
                         else
-                              outFiles.push_back(obj.value(key));
-                        }
-                  else if (key == "plugin")
-                        plugin = obj.value(key).toString();
-                  else {
-                        fprintf(stderr, "unknown key <%s>\n", qPrintable(key));
-                        return false;
+                              ++i;
                         }
+                  socket->deleteLater();
+                  });
+            }
+      }
+
+//---------------------------------------------------------
+//   reply
+//---------------------------------------------------------
+
+void ConvertServer::reply(QLocalSocket* socket, const QJsonObject& obj)
+      {
+      if (!socket || socket->state() != QLocalSocket::ConnectedState)
+            return;
+      socket->write(QJsonDocument(obj).toJson(QJsonDocument::Compact) + '\n');
+      socket->flush();
+      }
+
+//---------------------------------------------------------
+//   readRequests
+//---------------------------------------------------------
+
+void ConvertServer::readRequests(QLocalSocket* socket)
+      {
+      while (socket->canReadLine()) {
+            QByteArray line = socket->readLine().trimmed();
+            if (line.isEmpty())
+                  continue;
+            QJsonParseError pe;
+            QJsonDocument doc = QJsonDocument::fromJson(line, &pe);
+            if (pe.error != QJsonParseError::NoError || !doc.isObject()) {
+                  QJsonObject r;
+                  r["success"] = false;
+                  r["error"]   = pe.error != QJsonParseError::NoError ? pe.errorString() : QString("request is not an object");
+                  reply(socket, r);
+                  continue;
                   }
-            if (!convert(inFile, outFiles, plugin))
-                  return false;
+            request(socket, doc.object());
             }
-      return true;
+      }
+
+//---------------------------------------------------------
+//   request
+//---------------------------------------------------------
+
+void ConvertServer::request(QLocalSocket* socket, const QJsonObject& obj)
+      {
+      QJsonObject job = obj;
+      QJsonValue id   = job.take("id");
+      if (job.contains("quit")) {
+            _quit = true;
+            QJsonObject r;
+            r["id"]      = id;
+            r["success"] = true;
+            reply(socket, r);
+            if (!_running)
+                  _loop.quit();
+            return;
+            }
+      if (job.contains("cancel")) {
+            cancel(socket, id, job.value("cancel"));
+            return;
+            }
+      _queue.append({ socket, id, job });
+      scheduleNext();
+      }
+
+//---------------------------------------------------------
+//   cancel
+//    only queued jobs can be cancelled, a running
+//    conversion cannot be interrupted
+//---------------------------------------------------------
+
+void ConvertServer::cancel(QLocalSocket* socket, const QJsonValue& id, const QJsonValue& jobId)
+      {
+      bool found = false;
+      for (int i = 0; i < _queue.size(); ++i) {
+            if (_queue[i].socket == socket && _queue[i].id == jobId) {
+                  _queue.removeAt(i);
+                  found = true;
+                  break;
+                  }
+            }
+      if (found) {
+            QJsonObject r;
+            r["id"]        = jobId;
+            r["success"]   = false;
+            r["cancelled"] = true;
+            reply(socket, r);
+            }
+      QJsonObject r;
+      r["id"]      = id;
+      r["success"] = found;
+      if (!found)
+            r["error"] = QString("job is not queued");
+      reply(socket, r);
+      }
+
+//---------------------------------------------------------
+//   scheduleNext
+//    run jobs from the event loop, so that requests and
+//    cancellations are read between two jobs
+//---------------------------------------------------------
+
+void ConvertServer::scheduleNext()
+      {
+      if (!_running && !_queue.isEmpty())
+            QTimer::singleShot(0, [this]() { runNext(); });
+      }
+
+//---------------------------------------------------------
+//   runNext
+//---------------------------------------------------------
+
+void ConvertServer::runNext()
+      {
+      if (_running || _queue.isEmpty())
+            return;
+      Job job = _queue.takeFirst();
+      if (!job.socket) {
+            scheduleNext();
+            return;
+            }
+      _running = true;
+      QElapsedTimer timer;
+      timer.start();
+      QString inFile;
+      QJsonArray outFiles;
+      QString plugin;
+      QString error;
+      bool ok = parseJobEntry(job.job, inFile, outFiles, plugin, error)
+                && convert(inFile, outFiles, plugin, &error);
+      QJsonObject r = jobResult(QJsonValue(), ok, timer.elapsed(), error);
+      r["id"] = job.id;
+      reply(job.socket, r);
+      _running = false;
+      if (_quit)
+            _loop.quit();
+      else
+            scheduleNext();
       }
 
 //---------------------------------------------------------
@@ -3663,6 +4034,13 @@ static bool processNonGui(const QStringList& argv)
                   return res;
             }
       if (converterMode) {
+            if (!serverName.isEmpty()) {
+                  ConvertServer server;
+                  if (!server.listen(serverName))
+                        return false;
+                  server.exec();
+                  return true;
+                  }
             if (processJob)
                   return doProcessJob(jsonFileName);
             else
@@ -6809,6 +7187,7 @@ bool MuseScore::saveMp3(Score* score, QIODevice* device, bool& wasCanceled)
             if (!r)
                   synth->init();
             }
+      synth->setOffline(true);
 
       MScore::sampleRate = sampleRate;
 
@@ -7145,6 +7524,8 @@ int main(int argc, char* av[])
       parser.addOption(QCommandLineOption({"R", "revert-settings"}, "Revert to default preferences"));
       parser.addOption(QCommandLineOption({"i", "load-icons"}, "Load icons from INSTALLPATH/icons"));
       parser.addOption(QCommandLineOption({"j", "job"}, "Process a conversion job", "file"));
+      parser.addOption(QCommandLineOption(      "jobs", "Used with '-j <file>', process the job with N worker processes (0: one per core) and print a JSON report", "N"));
+      parser.addOption(QCommandLineOption(      "server", "Run as conversion server, read jobs from local socket 'name'", "name"));
       parser.addOption(QCommandLineOption({"e", "experimental"}, "Enable experimental features"));
       parser.addOption(QCommandLineOption({"c", "config-folder"}, "Override configuration and settings folder", "dir"));
       parser.addOption(QCommandLineOption({"t", "test-mode"}, "Set test mode flag for all files")); // this includes --template-mode
@@ -7205,6 +7586,23 @@ int main(int argc, char* av[])
                   fprintf(stderr, "json file name missing\n");
                   parser.showHelp(EXIT_FAILURE);
                   }
+            if ((jobReport = parser.isSet("jobs"))) {
+                  bool ok = false;
+                  jobWorkers = parser.value("jobs").toInt(&ok);
+                  if (!ok || jobWorkers < 0) {
+                        fprintf(stderr, "number of jobs '%s' not recognized\n", qPrintable(parser.value("jobs")));
+                        parser.showHelp(EXIT_FAILURE);
+                        }
+                  if (jobWorkers == 0)
+                        jobWorkers = QThread::idealThreadCount();
+                  }
+            }
+      if (parser.isSet("server")) {
+            MScore::noGui = true;
+            converterMode = true;
+            serverName = parser.value("server");
+            if (serverName.isEmpty())
+                  parser.showHelp(EXIT_FAILURE);
             }
       if ((pluginMode = parser.isSet("p"))) {
             MScore::noGui = true;
@@ -7730,14 +8128,7 @@ bool MuseScore::exportPartsPdfsToJSON(const QString& inFilePath, const QString&
       //if no parts, generate parts from existing instruments
       if (score->excerpts().size() == 0) {
             auto excerpts = Excerpt::createAllExcerpt(score);
-            for (Excerpt* e : excerpts) {
-                  Score* nscore = new Score(e->oscore());
-                  e->setPartScore(nscore);
-                  nscore->style().set(Sid::createMultiMeasureRests, true);
-                  Excerpt::createExcerpt(e);
-                  auto excerptCmdFake = new AddExcerpt(e);
-                  excerptCmdFake->redo(nullptr);
-            }
+            Excerpt::createExcerpts(score, excerpts, false);
       }
 
       QList<Score*> scores;
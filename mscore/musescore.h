@@ -731,6 +731,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore {
       bool saveSvg(Score*, QIODevice*, int pageNum = 0);
       bool savePng(Score*, QIODevice*, int pageNum = 0);
       bool savePng(Score*, const QString& name);
+      bool savePng(Score*, QList<QByteArray>& pngData);
       bool saveMidi(Score*, const QString& name);
       bool saveMidi(Score*, QIODevice*);
       bool savePositions(Score*, const QString& name, bool segments);
@@ -444,7 +444,7 @@ void PianoTools::retranslate()
 //   heartBeat
 //---------------------------------------------------------
 
-void PianoTools::setPlaybackNotes(QList<const Ms::Note *> notes)
+void PianoTools::setPlaybackNotes(const QSet<const Ms::Note*>& notes)
       {
       QSet<int> pitches;
       for (const Note* note : notes) {
@@ -111,7 +111,7 @@ class PianoTools : public QDockWidget {
       PianoTools(QWidget* parent = 0);
       void pressPitch(int pitch)    { _piano->pressPitch(pitch);   }
       void releasePitch(int pitch)  { _piano->releasePitch(pitch); }
-      void setPlaybackNotes(QList<const Note*> notes);
+      void setPlaybackNotes(const QSet<const Note*>& notes);
       void clearSelection();
       void changeSelection(const Selection& selection);
       };
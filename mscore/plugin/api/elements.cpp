@@ -70,28 +70,47 @@ void Note::setTpc(int val)
       }
 
 //---------------------------------------------------------
-//   wrap
+//   newWrapper
 ///   \cond PLUGIN_API \private \endcond
-///   Wraps Ms::Element choosing the correct wrapper type
-///   at runtime based on the actual element type.
+///   Creates a new wrapper for Ms::Element choosing the
+///   correct wrapper type at runtime based on the actual
+///   element type.
 //---------------------------------------------------------
 
-Element* wrap(Ms::Element* e, Ownership own)
+Element* newWrapper(Ms::Element* e, Ownership own)
       {
       using Ms::ElementType;
       switch(e->type()) {
             case ElementType::NOTE:
-                  return wrap<Note>(toNote(e), own);
+                  return newWrapper<Note>(toNote(e), own);
             case ElementType::CHORD:
-                  return wrap<Chord>(toChord(e), own);
+                  return newWrapper<Chord>(toChord(e), own);
             case ElementType::SEGMENT:
-                  return wrap<Segment>(toSegment(e), own);
+                  return newWrapper<Segment>(toSegment(e), own);
             case ElementType::MEASURE:
-                  return wrap<Measure>(toMeasure(e), own);
+                  return newWrapper<Measure>(toMeasure(e), own);
             default:
                   break;
             }
-      return wrap<Element>(e, own);
+      return newWrapper<Element>(e, own);
+      }
+
+//---------------------------------------------------------
+//   wrap
+///   \cond PLUGIN_API \private \endcond
+///   Wraps Ms::Element choosing the correct wrapper type
+///   at runtime based on the actual element type.
+//---------------------------------------------------------
+
+Element* wrap(Ms::Element* e, Ownership own)
+      {
+      if (!e)
+            return nullptr;
+      if (own == Ownership::SCORE)
+            return static_cast<Element*>(WrapperCache::wrapper(e));
+      Element* w = newWrapper(e, own);
+      QQmlEngine::setObjectOwnership(w, QQmlEngine::JavaScriptOwnership);
+      return w;
       }
 }
 }
@@ -33,6 +33,7 @@ class Element;
 //---------------------------------------------------------
 
 extern Element* wrap(Ms::Element* se, Ownership own = Ownership::SCORE);
+extern Element* newWrapper(Ms::Element* se, Ownership own);
 
 // TODO: add RESET functions
 #define API_PROPERTY(name, pid) \
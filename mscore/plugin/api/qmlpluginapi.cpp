@@ -73,6 +73,8 @@ void PluginAPI::initEnums() {
       PluginAPI::segmentTypeEnum = wrapEnum<Ms::SegmentType>();
       PluginAPI::spannerAnchorEnum = wrapEnum<Ms::Spanner::Anchor>();
 
+      WrapperCache::init();
+
       initialized = true;
       }
 
@@ -101,6 +101,8 @@ class Score : public Ms::PluginAPI::ScoreElement {
 
       Q_INVOKABLE QString extractLyrics() { return score()->extractLyrics(); }
 
+      Q_INVOKABLE QVariantList notes(Ms::PluginAPI::Segment* startSegment = nullptr, Ms::PluginAPI::Segment* endSegment = nullptr);
+
 //       //@ ??
 //       Q_INVOKABLE void updateRepeatList(bool expandRepeats) { score()->updateRepeatList(); } // TODO: needed?
 
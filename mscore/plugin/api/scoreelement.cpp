@@ -97,27 +97,107 @@ void ScoreElement::set(Ms::Pid pid, QVariant val)
       }
 
 //---------------------------------------------------------
-//   wrap
+//   newWrapper
 ///   \cond PLUGIN_API \private \endcond
-///   Wraps Ms::ScoreElement choosing the correct wrapper
-///   type at runtime based on the actual element type.
+///   Creates a new wrapper for Ms::ScoreElement choosing
+///   the correct wrapper type at runtime based on the
+///   actual element type.
 //---------------------------------------------------------
 
-ScoreElement* wrap(Ms::ScoreElement* se, Ownership own)
+ScoreElement* newWrapper(Ms::ScoreElement* se, Ownership own)
       {
       if (se->isElement())
-            return wrap(toElement(se), own);
+            return newWrapper(toElement(se), own);
 
       using Ms::ElementType;
       switch(se->type()) {
             case ElementType::SCORE:
-                  return wrap<Score>(toScore(se), own);
+                  return newWrapper<Score>(toScore(se), own);
             case ElementType::PART:
-                  return wrap<Part>(toPart(se), own);
+                  return newWrapper<Part>(toPart(se), own);
             default:
                   break;
             }
-      return wrap<ScoreElement>(se, own);
+      return newWrapper<ScoreElement>(se, own);
+      }
+
+//---------------------------------------------------------
+//   wrap
+///   \cond PLUGIN_API \private \endcond
+///   Wraps Ms::ScoreElement choosing the correct wrapper
+///   type at runtime based on the actual element type.
+//---------------------------------------------------------
+
+ScoreElement* wrap(Ms::ScoreElement* se, Ownership own)
+      {
+      if (!se)
+            return nullptr;
+      if (own == Ownership::SCORE)
+            return WrapperCache::wrapper(se);
+      ScoreElement* w = newWrapper(se, own);
+      QQmlEngine::setObjectOwnership(w, QQmlEngine::JavaScriptOwnership);
+      return w;
+      }
+
+//---------------------------------------------------------
+//   WrapperCache
+//---------------------------------------------------------
+
+QMutex WrapperCache::_mutex;
+QAtomicInt WrapperCache::_count;
+QHash<const Ms::ScoreElement*, ScoreElement*> WrapperCache::_wrappers;
+
+//---------------------------------------------------------
+//   WrapperCache::init
+///   Installs the element deletion hook, needs to be
+///   called before any wrapper gets cached.
+//---------------------------------------------------------
+
+void WrapperCache::init()
+      {
+      Ms::ScoreElement::deleteHook = &WrapperCache::elementDeleted;
+      }
+
+//---------------------------------------------------------
+//   WrapperCache::wrapper
+///   Returns the cached wrapper for a score-owned element,
+///   creating it on first access.
+//---------------------------------------------------------
+
+ScoreElement* WrapperCache::wrapper(Ms::ScoreElement* se)
+      {
+      QMutexLocker lock(&_mutex);
+      ScoreElement*& w = _wrappers[se];
+      if (!w) {
+            w = newWrapper(se, Ownership::SCORE);
+            _count.ref();
+            // The cache decides about the wrapper's lifetime,
+            // not the JavaScript garbage collector.
+            QQmlEngine::setObjectOwnership(w, QQmlEngine::CppOwnership);
+            }
+      return w;
+      }
+
+//---------------------------------------------------------
+//   WrapperCache::elementDeleted
+///   Called from Ms::ScoreElement destructor. Drops the
+///   wrapper of the deleted element, if any, so that it
+///   never gets handed out for another element allocated
+///   at the same address.
+///   Runs for every deleted element, so the mutex is only
+///   taken while at least one wrapper is cached.
+//---------------------------------------------------------
+
+void WrapperCache::elementDeleted(Ms::ScoreElement* se)
+      {
+      if (!_count.loadAcquire())
+            return;
+      QMutexLocker lock(&_mutex);
+      ScoreElement* w = _wrappers.take(se);
+      if (w) {
+            _count.deref();
+            w->deleteLater();
+            }
       }
 }
 }
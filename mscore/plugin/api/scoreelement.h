@@ -82,6 +82,45 @@ class ScoreElement : public QObject {
       Q_INVOKABLE QString userName() const;
       };
 
+//---------------------------------------------------------
+//   newWrapper
+///   \cond PLUGIN_API \private \endcond
+///   \internal
+///   Allocates a new wrapper object, bypassing the
+///   wrapper cache.
+//---------------------------------------------------------
+
+template <class Wrapper, class T>
+Wrapper* newWrapper(T* t, Ownership own)
+      {
+      return t ? new Wrapper(t, own) : nullptr;
+      }
+
+extern ScoreElement* newWrapper(Ms::ScoreElement* se, Ownership own);
+
+//---------------------------------------------------------
+//   WrapperCache
+///   \cond PLUGIN_API \private \endcond
+///   \internal
+///   Keeps a single wrapper object per score-owned element
+///   so that walking a score from QML does not allocate a
+///   new QObject on every access. Cached wrappers are owned
+///   by the cache and get released once the underlying
+///   element is deleted.
+//---------------------------------------------------------
+
+class WrapperCache {
+      static QMutex _mutex;
+      static QAtomicInt _count;     // number of cached wrappers, checked before locking
+      static QHash<const Ms::ScoreElement*, ScoreElement*> _wrappers;
+
+      static void elementDeleted(Ms::ScoreElement* se);
+
+   public:
+      static void init();
+      static ScoreElement* wrapper(Ms::ScoreElement* se);
+      };
+
 //---------------------------------------------------------
 //   wrap
 ///   \cond PLUGIN_API \private \endcond
@@ -92,8 +131,14 @@ class ScoreElement : public QObject {
 template <class Wrapper, class T>
 Wrapper* wrap(T* t, Ownership own = Ownership::SCORE)
       {
-      Wrapper* w = t ? new Wrapper(t, own) : nullptr;
-      // All wrapper objects should belong to JavaScript code.
+      if (!t)
+            return nullptr;
+      if (own == Ownership::SCORE) {
+            if (Wrapper* w = qobject_cast<Wrapper*>(WrapperCache::wrapper(t)))
+                  return w;
+            }
+      Wrapper* w = newWrapper<Wrapper>(t, own);
+      // Uncached wrapper objects should belong to JavaScript code.
       QQmlEngine::setObjectOwnership(w, QQmlEngine::JavaScriptOwnership);
       return w;
       }
@@ -142,6 +142,8 @@ enum class MusicxmlExportBreaks : char {
 #define PREF_IO_PORTMIDI_OUTPUTDEVICE                       "io/portMidi/outputDevice"
 #define PREF_IO_PORTMIDI_OUTPUTLATENCYMILLISECONDS          "io/portMidi/outputLatencyMilliseconds"
 #define PREF_IO_PULSEAUDIO_USEPULSEAUDIO                    "io/pulseAudio/usePulseAudio"
+#define PREF_IO_ZERBERUS_PRELOADFRAMES                      "io/zerberus/preloadFrames"
+#define PREF_IO_ZERBERUS_STREAMSAMPLES                      "io/zerberus/streamSamples"
 #define PREF_SCORE_CHORD_PLAYONADDNOTE                      "score/chord/playOnAddNote"
 #define PREF_SCORE_MAGNIFICATION                            "score/magnification"
 #define PREF_SCORE_NOTE_PLAYONCLICK                         "score/note/playOnClick"
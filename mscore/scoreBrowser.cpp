@@ -14,6 +14,7 @@
 #include "musescore.h"
 #include "icons.h"
 #include "libmscore/score.h"
+#include "thirdparty/qzip/qzipreader_p.h"
 
 namespace Ms {
 
@@ -49,8 +50,149 @@ class ScoreItem : public QListWidgetItem
    public:
       ScoreItem(const ScoreInfo& i) : QListWidgetItem(), _info(i) {}
       const ScoreInfo& info() const { return _info; }
+      void setPixmap(const QPixmap& pm) { _info.setPixmap(pm); setIcon(QIcon(pm)); }
       };
 
+//---------------------------------------------------------
+//   thumbnailCacheFile
+//    on disk thumbnails are keyed by path, modification
+//    time and size of the score file; a ".failed" file
+//    marks a score which could not be laid out
+//---------------------------------------------------------
+
+static QString thumbnailCacheFile(const QFileInfo& fi, const char* suffix = "png")
+      {
+      static const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails";
+      QByteArray key = fi.absoluteFilePath().toUtf8();
+      key += '\n' + QByteArray::number(fi.lastModified().toMSecsSinceEpoch());
+      key += '\n' + QByteArray::number(fi.size());
+      return QString("%1/%2.%3").arg(dir).arg(QString(QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex())).arg(suffix);
+      }
+
+//---------------------------------------------------------
+//   thumbnailCache
+//    scaled thumbnails of the score browsers, keyed by
+//    path and icon size; the cost is the pixmap size in KB
+//---------------------------------------------------------
+
+static QCache<QString, QPixmap>& thumbnailCache()
+      {
+      static QCache<QString, QPixmap> cache(32 * 1024);     // 32 MB
+      return cache;
+      }
+
+static QString thumbnailCacheKey(const QString& path, const QSize& size)
+      {
+      return QString("%1@%2x%3").arg(path).arg(size.width()).arg(size.height());
+      }
+
+static void cacheThumbnail(const QString& key, const QPixmap& pm)
+      {
+      int cost = qMax(1, pm.width() * pm.height() * pm.depth() / (8 * 1024));
+      thumbnailCache().insert(key, new QPixmap(pm), cost);
+      }
+
+//---------------------------------------------------------
+//   saveThumbnail
+//---------------------------------------------------------
+
+static void saveThumbnail(const QImage& image, const QString& cacheFile)
+      {
+      if (image.isNull() || !QDir().mkpath(QFileInfo(cacheFile).absolutePath()))
+            return;
+      // write to a temporary file first so a concurrent reader never sees a partial image
+      QString tmp = cacheFile + ".tmp";
+      if (image.save(tmp, "PNG")) {
+            QFile::remove(cacheFile);
+            QFile::rename(tmp, cacheFile);
+            }
+      }
+
+//---------------------------------------------------------
+//   layoutThumbnail
+//    Runs in a worker thread. Read the score into a private
+//    MasterScore, lay it out and render the first page.
+//    Returns a null image if the score cannot be read.
+//---------------------------------------------------------
+
+static QImage layoutThumbnail(const QString& path)
+      {
+      QImage image;
+      if (!(path.endsWith(".mscx") || path.endsWith(".mscz")))
+            return image;
+      MasterScore* score = new MasterScore(MScore::defaultStyle());
+      Score::FileError error = score->loadMsc(path, true);
+      if (error == Score::FileError::FILE_NO_ERROR && score->firstMeasure()) {
+            score->doLayout();
+            if (!score->pages().isEmpty())
+                  image = score->renderThumbnail();
+            }
+      delete score;
+      return image;
+      }
+
+//---------------------------------------------------------
+//   readThumbnail
+//    Runs in a worker thread. Returns the cached thumbnail,
+//    the one embedded in a .mscz file or lays out the score
+//    to create one. A null image means the score cannot be
+//    read; this is remembered in failedFile.
+//---------------------------------------------------------
+
+static QImage readThumbnail(const QString& path, const QString& cacheFile, const QString& failedFile)
+      {
+      QImage image;
+      if (image.load(cacheFile, "PNG") || QFileInfo::exists(failedFile))
+            return image;
+      if (path.endsWith(".mscz")) {
+            MQZipReader uz(path);
+            if (uz.exists()) {
+                  QByteArray ba = uz.fileData("Thumbnails/thumbnail.png");
+                  if (!ba.isEmpty() && image.loadFromData(ba, "PNG")) {
+                        saveThumbnail(image, cacheFile);
+                        return image;
+                        }
+                  }
+            }
+      image = layoutThumbnail(path);
+      if (!image.isNull())
+            saveThumbnail(image, cacheFile);
+      else if (QDir().mkpath(QFileInfo(failedFile).absolutePath())) {
+            QFile f(failedFile);
+            f.open(QIODevice::WriteOnly);
+            }
+      return image;
+      }
+
+//---------------------------------------------------------
+//   thumbnailPixmap
+//    scale the thumbnail to the icon size and add a border
+//---------------------------------------------------------
+
+static QPixmap thumbnailPixmap(const QFileInfo& fi, const QPixmap& thumbnail, const QSize& size)
+      {
+      QPixmap pm(size);
+      QPixmap pixmap = thumbnail.scaled(pm.width() - 2, pm.height() - 2, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+      // draw pixmap and add border
+      pm.fill(Qt::transparent);
+      QPainter painter( &pm );
+      painter.setRenderHint(QPainter::Antialiasing);
+      painter.setRenderHint(QPainter::TextAntialiasing);
+      painter.drawPixmap(0, 0, pixmap);
+      painter.setPen(QPen(QColor(0, 0, 0, 128), 1));
+      painter.setBrush(Qt::white);
+      if (fi.completeBaseName() == "00-Blank" || fi.completeBaseName() == "Create_New_Score") {
+            qreal round = 8.0 * qApp->devicePixelRatio();
+            painter.drawRoundedRect(QRectF(0, 0, pm.width() - 1 , pm.height() - 1), round, round);
+            }
+      else
+            painter.drawRect(0, 0, pm.width()  - 1, pm.height()  - 1);
+      if (fi.completeBaseName() != "00-Blank")
+            painter.drawPixmap(1, 1, pixmap);
+      painter.end();
+      return pm;
+      }
+
 //---------------------------------------------------------
 //   ScoreBrowser
 //---------------------------------------------------------
@@ -116,31 +258,16 @@ ScoreItem* ScoreBrowser::genScoreItem(const QFileInfo& fi, ScoreListWidget* l)
       {
       ScoreInfo si(fi);
 
-      QPixmap pm(l->iconSize() * qApp->devicePixelRatio());
-      if (!QPixmapCache::find(fi.filePath(), &pm)) {
-            //load and scale pixmap
-            QPixmap pixmap = mscore->extractThumbnail(fi.filePath());
-            if (pixmap.isNull())
-                  pixmap = icons[int(Icons::file_ICON)]->pixmap(QSize(50,60));
-            pixmap = pixmap.scaled(pm.width() - 2, pm.height() - 2, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-            // draw pixmap and add border
-            pm.fill(Qt::transparent);
-            QPainter painter( &pm );
-            painter.setRenderHint(QPainter::Antialiasing);
-            painter.setRenderHint(QPainter::TextAntialiasing);
-            painter.drawPixmap(0, 0, pixmap);
-            painter.setPen(QPen(QColor(0, 0, 0, 128), 1));
-            painter.setBrush(Qt::white);
-            if (fi.completeBaseName() == "00-Blank" || fi.completeBaseName() == "Create_New_Score") {
-                  qreal round = 8.0 * qApp->devicePixelRatio();
-                  painter.drawRoundedRect(QRectF(0, 0, pm.width() - 1 , pm.height() - 1), round, round);
-                  }
-            else
-                  painter.drawRect(0, 0, pm.width()  - 1, pm.height()  - 1);
-            if (fi.completeBaseName() != "00-Blank")
-                  painter.drawPixmap(1, 1, pixmap);
-            painter.end();
-            QPixmapCache::insert(fi.filePath(), pm);
+      QPixmap pm;
+      QSize size = l->iconSize() * qApp->devicePixelRatio();
+      const QPixmap* cpm = thumbnailCache().object(thumbnailCacheKey(fi.filePath(), size));
+      bool cached = cpm != 0;
+      if (cached)
+            pm = *cpm;
+      else {
+            // show a placeholder until the thumbnail is loaded in the background
+            QPixmap placeholder = icons[int(Icons::file_ICON)]->pixmap(QSize(50,60));
+            pm = thumbnailPixmap(fi, placeholder, size);
             }
 
       si.setPixmap(pm);
@@ -169,15 +296,76 @@ ScoreItem* ScoreBrowser::genScoreItem(const QFileInfo& fi, ScoreListWidget* l)
       item->setTextAlignment(Qt::AlignHCenter | Qt::AlignTop);
       item->setIcon(QIcon(pm));
       item->setSizeHint(l->cellSize());
+      if (!cached)
+            requestThumbnail(fi, item);
       return item;
       }
 
+//---------------------------------------------------------
+//   requestThumbnail
+//    Load the thumbnail for item from the disk cache or
+//    the score file on the thread pool. Scores without
+//    embedded thumbnail are laid out there too.
+//---------------------------------------------------------
+
+void ScoreBrowser::requestThumbnail(const QFileInfo& fi, ScoreItem* item)
+      {
+      QString path = fi.filePath();
+      bool running = _pendingThumbnails.contains(path);
+      _pendingThumbnails.insert(path, item);
+      if (running)
+            return;
+
+      int generation = _thumbnailGeneration;
+      QFutureWatcher<QImage>* watcher = new QFutureWatcher<QImage>(this);
+      connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, path, generation]() {
+            QImage image = watcher->result();
+            watcher->deleteLater();
+            if (generation == _thumbnailGeneration)
+                  setThumbnail(path, image);
+            });
+      watcher->setFuture(QtConcurrent::run(&_thumbnailPool, readThumbnail, path, thumbnailCacheFile(fi), thumbnailCacheFile(fi, "failed")));
+      }
+
+//---------------------------------------------------------
+//   setThumbnail
+//    replace the placeholder of all items showing path
+//---------------------------------------------------------
+
+void ScoreBrowser::setThumbnail(const QString& path, const QImage& image)
+      {
+      QList<ScoreItem*> items = _pendingThumbnails.values(path);
+      _pendingThumbnails.remove(path);
+      if (items.isEmpty() || image.isNull())
+            return;
+      QPixmap thumbnail = QPixmap::fromImage(image);
+      for (ScoreItem* item : items) {
+            QSize size = item->listWidget()->iconSize() * qApp->devicePixelRatio();
+            QPixmap pm = thumbnailPixmap(item->info(), thumbnail, size);
+            cacheThumbnail(thumbnailCacheKey(path, size), pm);
+            item->setPixmap(pm);
+            }
+      }
+
+//---------------------------------------------------------
+//   clearThumbnailRequests
+//    forget about items which are going to be deleted;
+//    results of running requests are dropped
+//---------------------------------------------------------
+
+void ScoreBrowser::clearThumbnailRequests()
+      {
+      ++_thumbnailGeneration;
+      _pendingThumbnails.clear();
+      }
+
 //---------------------------------------------------------
 //   setScores
 //---------------------------------------------------------
 
 void ScoreBrowser::setScores(QFileInfoList& s)
       {
+      clearThumbnailRequests();
       qDeleteAll(scoreLists);
       scoreLists.clear();
 
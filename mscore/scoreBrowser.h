@@ -60,8 +60,15 @@ class ScoreBrowser : public QWidget, public Ui::ScoreBrowser
       bool _showCustomCategory  { false };// show a custom category for files
       QLabel* _noMatchedScoresLabel;      // displayed when no scores are matching the search
 
+      QThreadPool _thumbnailPool;
+      QMultiHash<QString, ScoreItem*> _pendingThumbnails;   // items still showing the placeholder
+      int _thumbnailGeneration  { 0 };
+
       ScoreListWidget* createScoreList();
       ScoreItem* genScoreItem(const QFileInfo&, ScoreListWidget*);
+      void requestThumbnail(const QFileInfo&, ScoreItem*);
+      void setThumbnail(const QString& path, const QImage&);
+      void clearThumbnailRequests();
 
    private slots:
       void scoreClicked(QListWidgetItem*);
@@ -1615,12 +1615,10 @@ void ScoreView::normalCopy()
       {
       if (!checkCopyOrCut())
             return;
-      QString mimeType = _score->selection().mimeType();
-      if (!mimeType.isEmpty()) {
-            QMimeData* mimeData = new QMimeData;
-            mimeData->setData(mimeType, _score->selection().mimeData());
+      QMimeData* mimeData = _score->selection().createMimeData();
+      if (mimeData) {
             if (MScore::debugMode)
-                  qDebug("cmd copy: <%s>", mimeData->data(mimeType).data());
+                  qDebug("cmd copy: <%s>", mimeData->data(_score->selection().mimeType()).data());
             QApplication::clipboard()->setMimeData(mimeData);
             }
       }
@@ -1710,12 +1708,11 @@ void ScoreView::normalSwap()
                   ms = QApplication::clipboard()->mimeData();
                   }
             }
-      QByteArray d(_score->selection().mimeData());
-      if (this->normalPaste()) {
-            QMimeData* mimeData = new QMimeData;
-            mimeData->setData(mimeType, d);
+      QMimeData* mimeData = _score->selection().createMimeData();
+      if (this->normalPaste())
             QApplication::clipboard()->setMimeData(mimeData);
-            }
+      else
+            delete mimeData;
       }
 
 //---------------------------------------------------------
@@ -4186,11 +4183,12 @@ void ScoreView::cmdRepeatSelection()
             qDebug("mime type is empty");
             return;
             }
-      QMimeData* mimeData = new QMimeData;
-      mimeData->setData(mimeType, selection.mimeData());
+      QMimeData* mimeData = selection.createMimeData();
       if (MScore::debugMode)
             qDebug("cmdRepeatSelection: <%s>", mimeData->data(mimeType).data());
       QApplication::clipboard()->setMimeData(mimeData);
+      StaffListMimeData* staffListData = qobject_cast<StaffListMimeData*>(mimeData);
+      StaffListClone* staffList = staffListData ? staffListData->staffList() : 0;
 
       QByteArray d(mimeData->data(mimeType));
       XmlReader xml(d);
@@ -4206,7 +4204,10 @@ void ScoreView::cmdRepeatSelection()
             if (e) {
                   ChordRest* cr = toChordRest(e);
                   _score->startCmd();
-                  _score->pasteStaff(xml, cr->segment(), cr->staffIdx());
+                  if (staffList)
+                        _score->pasteStaff(*staffList, cr->segment(), cr->staffIdx());
+                  else
+                        _score->pasteStaff(xml, cr->segment(), cr->staffIdx());
                   _score->endCmd();
                   }
             else
@@ -17,6 +17,8 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include <algorithm>
+
 #include "config.h"
 #include "seq.h"
 #include "musescore.h"
@@ -227,6 +229,7 @@ void Seq::setScoreView(ScoreView* v)
             heartBeatTimer->start(20);    // msec
 
       playlistChanged = true;
+      changedTick1    = -1;
       _synti->reset();
       if (cs) {
             initInstruments();
@@ -1002,16 +1005,79 @@ void Seq::initInstruments(bool realTime)
             }
       }
 
+//---------------------------------------------------------
+//   setPlaylistChanged
+//    remember which ticks of the playlist have changed,
+//    collectEvents() renders only these again
+//---------------------------------------------------------
+
+void Seq::setPlaylistChanged()
+      {
+      if (!cs || cs->playlistDirtyAll() || (playlistChanged && changedTick1 < 0)) {
+            changedTick1 = -1;
+            changedTick2 = -1;
+            }
+      else if (!playlistChanged) {
+            changedTick1 = cs->playlistDirtyTick1().ticks();
+            changedTick2 = cs->playlistDirtyTick2().ticks();
+            }
+      else {
+            changedTick1 = qMin(changedTick1, cs->playlistDirtyTick1().ticks());
+            changedTick2 = qMax(changedTick2, cs->playlistDirtyTick2().ticks());
+            }
+      playlistChanged = true;
+      }
+
 //---------------------------------------------------------
 //   renderChunk
 //---------------------------------------------------------
 
-void Seq::renderChunk(const MidiRenderer::Chunk& ch, EventMap* eventMap)
+void Seq::renderChunk(const MidiRenderer::Chunk& ch, EventMap* eventMap, HighlightMap* highlightMap)
       {
-      midi.renderChunk(ch, eventMap, mscore->synthesizerState(), /* metronome */ true);
+      EventMap chunkEvents;
+      midi.renderChunk(ch, &chunkEvents, mscore->synthesizerState(), /* metronome */ true);
+
+      // resolve the notes to mark while the chunk is played
+      ChunkHighlights& hl = (*highlightMap)[ch.utick1()];
+      hl.notes.clear();
+      for (const auto& p : chunkEvents) {
+            const NPlayEvent& n = p.second;
+            if (n.type() != ME_NOTEON)
+                  continue;
+            for (const Note* note1 = n.note(); note1; note1 = note1->tieFor() ? note1->tieFor()->endNote() : 0) {
+                  for (ScoreElement* se : note1->linkList()) {
+                        if (se->isNote())
+                              hl.notes.push_back({ p.first, n.velo() != 0, toNote(se) });
+                        }
+                  }
+            }
+      std::stable_sort(hl.notes.begin(), hl.notes.end(), [](const NoteHighlight& a, const NoteHighlight& b) {
+            return a.utick < b.utick || (a.utick == b.utick && !a.on && b.on);
+            });
+      hl.endUtick = hl.notes.empty() ? ch.utick1() : hl.notes.back().utick + 1;
+
+      eventMap->insert(chunkEvents.begin(), chunkEvents.end());
       renderEventsStatus.setOccupied(ch.utick1(), ch.utick2());
       }
 
+//---------------------------------------------------------
+//   mergeRenderEvents
+//    move the events and note marks rendered in background
+//    to the playlist; called with mutex locked
+//---------------------------------------------------------
+
+void Seq::mergeRenderEvents()
+      {
+      // TODO: use C++17 map::merge()?
+      events.insert(renderEvents.begin(), renderEvents.end());
+      renderEvents.clear();
+      for (auto& h : renderHighlights) {
+            highlightSpan = qMax(highlightSpan, h.second.endUtick - h.first);
+            highlights[h.first] = std::move(h.second);
+            }
+      renderHighlights.clear();
+      }
+
 //---------------------------------------------------------
 //   updateEventsEnd
 //---------------------------------------------------------
@@ -1038,15 +1104,26 @@ void Seq::collectEvents(int utick)
       if (midiRenderFuture.isRunning())
             midiRenderFuture.waitForFinished();
 
-      if (playlistChanged) {
+      if (playlistChanged && changedTick1 < 0) {
             midi.setScoreChanged();
             events.clear();
             renderEvents.clear();
             renderEventsStatus.clear();
+            highlights.clear();
+            renderHighlights.clear();
+            highlightSpan = 0;
             }
-      else if (!renderEvents.empty()) {
-            events.insert(renderEvents.begin(), renderEvents.end());
-            renderEvents.clear();
+      else {
+            if (!renderEvents.empty())
+                  mergeRenderEvents();
+            if (playlistChanged) {
+                  // keep events of chunks not touched by the change
+                  for (const std::pair<int, int>& r : midi.setScoreChanged(changedTick1, changedTick2)) {
+                        events.eraseRange(r.first, r.second);
+                        renderEventsStatus.setUnoccupied(r.first, r.second);
+                        highlights.erase(highlights.lower_bound(r.first), highlights.lower_bound(r.second));
+                        }
+                  }
             }
 
       int unrenderedUtick = renderEventsStatus.occupiedRangeEnd(utick);
@@ -1054,7 +1131,8 @@ void Seq::collectEvents(int utick)
             const MidiRenderer::Chunk chunk = midi.getChunkAt(unrenderedUtick);
             if (!chunk)
                   break;
-            renderChunk(chunk, &events);
+            renderChunk(chunk, &events, &highlights);
+            highlightSpan = qMax(highlightSpan, highlights[chunk.utick1()].endUtick - chunk.utick1());
             unrenderedUtick = renderEventsStatus.occupiedRangeEnd(utick);
             }
 
@@ -1078,10 +1156,8 @@ void Seq::ensureBufferAsync(int utick)
                   }
 
             if (!renderEvents.empty()) {
-                  // TODO: use C++17 map::merge()?
-                  events.insert(renderEvents.begin(), renderEvents.end());
+                  mergeRenderEvents();
                   updateEventsEnd();
-                  renderEvents.clear();
                   }
 
             const int unrenderedUtick = renderEventsStatus.occupiedRangeEnd(utick);
@@ -1089,7 +1165,7 @@ void Seq::ensureBufferAsync(int utick)
                   const MidiRenderer::Chunk chunk = midi.getChunkAt(unrenderedUtick);
                   if (chunk) {
                         midiRenderFuture = QtConcurrent::run([this, chunk]() {
-                              renderChunk(chunk, &renderEvents);
+                              renderChunk(chunk, &renderEvents, &renderHighlights);
                               });
                         }
                   }
@@ -1178,6 +1254,7 @@ void Seq::seekCommon(int utick)
             }
 
       guiPos = events.lower_bound(utick);
+      guiHighlightUtick = utick;
       mscore->setPos(Fraction::fromTicks(cs->repeatList().utick2tick(utick)));
       unmarkNotes();
       }
@@ -1524,6 +1601,44 @@ void Seq::putEvent(const NPlayEvent& event, unsigned framePos)
             _driver->putEvent(event, framePos);
       }
 
+//---------------------------------------------------------
+//   markNotes
+//    Mark and unmark the notes sounding in utick range
+//    [utick1, utick2) and add their area to r. Marks of
+//    a chunk can reach into the following chunks, so the
+//    marks of all chunks are merged in utick order. Only
+//    chunks starting less than highlightSpan before
+//    utick1 can have marks in the range.
+//---------------------------------------------------------
+
+void Seq::markNotes(int utick1, int utick2, QRectF& r)
+      {
+      std::vector<const NoteHighlight*> hl;
+      for (auto c = highlights.lower_bound(utick1 - highlightSpan + 1); c != highlights.end(); ++c) {
+            if (c->first >= utick2)
+                  break;
+            const std::vector<NoteHighlight>& notes = c->second.notes;
+            if (c->second.endUtick <= utick1)
+                  continue;
+            auto i = std::lower_bound(notes.begin(), notes.end(), utick1, [](const NoteHighlight& h, int utick) {
+                  return h.utick < utick;
+                  });
+            for (; i != notes.end() && i->utick < utick2; ++i)
+                  hl.push_back(&*i);
+            }
+      std::stable_sort(hl.begin(), hl.end(), [](const NoteHighlight* a, const NoteHighlight* b) {
+            return a->utick < b->utick || (a->utick == b->utick && !a->on && b->on);
+            });
+      for (const NoteHighlight* h : hl) {
+            h->note->setMark(h->on);
+            if (h->on)
+                  markedNotes.insert(h->note);
+            else
+                  markedNotes.remove(h->note);
+            r |= h->note->canvasBoundingRect();
+            }
+      }
+
 //---------------------------------------------------------
 //   heartBeat
 //    update GUI
@@ -1575,43 +1690,18 @@ void Seq::heartBeatTimeout()
             emit tempoChanged();
             }
 
-      QRectF r;
       for (;guiPos != eventsEnd; ++guiPos) {
             if (guiPos->first > ppos->first)
                   break;
             if (mscore->loop())
                   if (guiPos->first >= cs->repeatList().tick2utick(cs->loopOutTick().ticks()))
                         break;
-            const NPlayEvent& n = guiPos->second;
-            if (n.type() == ME_NOTEON) {
-                  const Note* note1 = n.note();
-                  if (n.velo()) {
-                        while (note1) {
-                              for (ScoreElement* se : note1->linkList()) {
-                                    if (!se->isNote())
-                                          continue;
-                                    Note* currentNote = toNote(se);
-                                    currentNote->setMark(true);
-                                    markedNotes.append(currentNote);
-                                    r |= currentNote->canvasBoundingRect();
-                                    }
-                              note1 = note1->tieFor() ? note1->tieFor()->endNote() : 0;
-                              }
-                        }
-                  else {
-                        while (note1) {
-                              for (ScoreElement* se : note1->linkList()) {
-                                    if (!se->isNote())
-                                          continue;
-                                    Note* currentNote = toNote(se);
-                                    currentNote->setMark(false);
-                                    r |= currentNote->canvasBoundingRect();
-                                    markedNotes.removeOne(currentNote);
-                                    }
-                              note1 = note1->tieFor() ? note1->tieFor()->endNote() : 0;
-                              }
-                        }
-                  }
+            }
+      QRectF r;
+      int guiUtick = guiPos != eventsEnd ? guiPos->first : endUTick + 1;
+      if (guiUtick > guiHighlightUtick) {
+            markNotes(guiHighlightUtick, guiUtick, r);
+            guiHighlightUtick = guiUtick;
             }
       int utick = ppos->first;
       int t = cs->repeatList().utick2tick(utick);
@@ -20,6 +20,9 @@
 #ifndef __SEQ_H__
 #define __SEQ_H__
 
+#include <map>
+#include <vector>
+
 #include "libmscore/rendermidi.h"
 #include "libmscore/sequencer.h"
 #include "libmscore/fraction.h"
@@ -88,6 +91,31 @@ class SeqMsgFifo : public FifoBase {
       SeqMsg dequeue();                   // remove object from fifo
       };
 
+//---------------------------------------------------------
+//   NoteHighlight
+//    a note to mark or unmark while playing
+//---------------------------------------------------------
+
+struct NoteHighlight {
+      int utick;
+      bool on;
+      const Note* note;
+      };
+
+//---------------------------------------------------------
+//   ChunkHighlights
+//    The note marks of one rendered chunk, sorted by utick
+//    with unmarks first. Ties and linked notes are already
+//    resolved.
+//---------------------------------------------------------
+
+struct ChunkHighlights {
+      std::vector<NoteHighlight> notes;
+      int endUtick { 0 };                 // past the last entry, may be after the chunk end
+      };
+
+typedef std::map<int, ChunkHighlights> HighlightMap;    // chunk start utick -> note marks
+
 // this are also the jack audio transport states:
 enum class Transport : char {
       STOP=0,
@@ -123,6 +151,8 @@ class Seq : public QObject, public Sequencer {
 
       bool oggInit;
       bool playlistChanged;
+      int changedTick1 { -1 };            // tick range changed since the last collectEvents(),
+      int changedTick2 { -1 };            // -1 if the whole playlist has to be rendered again
 
       SeqMsgFifo toSeq;
       SeqMsgFifo fromSeq;
@@ -137,6 +167,8 @@ class Seq : public QObject, public Sequencer {
       EventMap::const_iterator eventsEnd;
       EventMap renderEvents;              // event list that is rendered in background
       RangeMap renderEventsStatus;
+      HighlightMap highlights;            // note marks for events
+      HighlightMap renderHighlights;      // note marks for renderEvents
       MidiRenderer midi;
       QFuture<void> midiRenderFuture;
       bool allowBackgroundRendering = false; // should be set to true only when playing, so no
@@ -151,8 +183,10 @@ class Seq : public QObject, public Sequencer {
       EventMap::const_iterator playPos;   // moved in real time thread
       EventMap::const_iterator countInPlayPos;
       EventMap::const_iterator guiPos;    // moved in gui thread
+      int guiHighlightUtick { 0 };        // note marks before this utick are done
+      int highlightSpan { 0 };            // longest utick range of the marks of a chunk in highlights
 
-      QList<const Note*> markedNotes;     // notes marked as sounding
+      QSet<const Note*> markedNotes;      // notes marked as sounding
 
       uint tackRemain;        // metronome state (remaining audio samples)
       uint tickRemain;
@@ -165,7 +199,9 @@ class Seq : public QObject, public Sequencer {
       QTimer* heartBeatTimer;
       QTimer* noteTimer;
 
-      void renderChunk(const MidiRenderer::Chunk&, EventMap*);
+      void renderChunk(const MidiRenderer::Chunk&, EventMap*, HighlightMap*);
+      void mergeRenderEvents();
+      void markNotes(int utick1, int utick2, QRectF& r);
       void updateEventsEnd();
 
       void setPos(int);
@@ -185,7 +221,7 @@ class Seq : public QObject, public Sequencer {
       void seqMessage(int msg, int arg = 0);
       void heartBeatTimeout();
       void midiInputReady();
-      void setPlaylistChanged() { playlistChanged = true; }
+      void setPlaylistChanged();
       void handleTimeSigTempoChanged();
 
    public slots:
@@ -272,9 +272,7 @@ void Workspace::write()
       xml.stag("rootfiles");
       xml.stag(QString("rootfile full-path=\"%1\"").arg(XmlWriter::xmlString("workspace.xml")));
       xml.etag();
-      for (ImageStoreItem* ip : imageStore) {
-            if (!ip->isUsed(gscore))
-                  continue;
+      for (ImageStoreItem* ip : imageStore.usedItems(gscore)) {
             QString dstPath = QString("Pictures/") + ip->hashName();
             xml.tag("file", dstPath);
             }
@@ -284,9 +282,7 @@ void Workspace::write()
       f.addFile("META-INF/container.xml", cbuf.data());
 
       // save images
-      for (ImageStoreItem* ip : imageStore) {
-            if (!ip->isUsed(gscore))
-                  continue;
+      for (ImageStoreItem* ip : imageStore.usedItems(gscore)) {
             QString dstPath = QString("Pictures/") + ip->hashName();
             f.addFile(dstPath, ip->buffer());
             }
@@ -0,0 +1,324 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "effects/zita1/zita.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   ReferenceReverb
+//    sample by sample implementation of the Zita delay
+//    network, as it was before block processing; default
+//    parameters only
+//---------------------------------------------------------
+
+class ReferenceReverb
+      {
+      struct Line {
+            std::vector<float> data;
+            int i { 0 };
+            void init(int size) { data.assign(size, 0.0f); i = 0; }
+            float read() const  { return data[i]; }
+            void write(float x) {
+                  data[i] = x;
+                  if (++i == int(data.size()))
+                        i = 0;
+                  }
+            };
+      struct Diffuser : Line {
+            float c;
+            float process(float x) {
+                  float z = read();
+                  x -= c * z;
+                  write(x);
+                  return z + c * x;
+                  }
+            };
+      struct VarLine : Line {
+            int ir { 0 };
+            float readDelayed() {
+                  float x = data[ir];
+                  if (++ir == int(data.size()))
+                        ir = 0;
+                  return x;
+                  }
+            };
+      struct Filter {
+            float gmf, glo, wlo, whi;
+            float slo { 0.0f };
+            float shi { 0.0f };
+            void setParams(float del, float tmf, float tlo, float wl, float thi, float chi) {
+                  gmf = powf(0.001f, del / tmf);
+                  glo = powf(0.001f, del / tlo) / gmf - 1.0f;
+                  wlo = wl;
+                  float g = powf(0.001f, del / thi) / gmf;
+                  float t = (1 - g * g) / (2 * g * g * chi);
+                  whi = (sqrtf(1 + 4 * t) - 1) / (2 * t);
+                  }
+            float process(float x) {
+                  slo += wlo * (x - slo) + 1e-10f;
+                  x += glo * slo;
+                  shi += whi * (x - shi);
+                  return gmf * shi;
+                  }
+            };
+
+      static const int FRAGMENT = 1024;
+
+      float _fsamp;
+      VarLine _vdelay[2];
+      Diffuser _diff[8];
+      Line _delay[8];
+      Filter _filt[8];
+      Pareq _pareq1;
+      Pareq _pareq2;
+      float _g0 { 0.0f }, _d0 { 0.0f };
+      float _g1 { 0.0f }, _d1 { 0.0f };
+      int _nsamp { 0 };
+      bool _prepared { false };
+
+      void prepare();
+
+   public:
+      ReferenceReverb(float fsamp);
+      void process(int nfram, const float* inp, float* out);
+      };
+
+ReferenceReverb::ReferenceReverb(float fsamp)
+   : _fsamp(fsamp)
+      {
+      static const float tdiff[8] = {
+            20346e-6f, 24421e-6f, 31604e-6f, 27333e-6f, 22904e-6f, 29291e-6f, 13458e-6f, 19123e-6f
+            };
+      static const float tdelay[8] = {
+            153129e-6f, 210389e-6f, 127837e-6f, 256891e-6f, 174713e-6f, 192303e-6f, 125000e-6f, 219991e-6f
+            };
+      const float rtlow = 1.4f;
+      const float rtmid = 2.0f;
+      const float xover = 200.0f;
+      const float fdamp = 3e3f;
+
+      for (VarLine& l : _vdelay) {
+            l.init(int(0.1f * _fsamp));
+            l.ir = l.i - int(floorf((0.04f - 0.020f) * _fsamp + 0.5f));
+            if (l.ir < 0)
+                  l.ir += int(l.data.size());
+            }
+      const float wlo = 6.2832f * xover / _fsamp;
+      const float chi = 1 - cosf(6.2832f * fdamp / _fsamp);
+      for (int i = 0; i < 8; ++i) {
+            int k1 = int(floorf(tdiff[i] * _fsamp + 0.5f));
+            int k2 = int(floorf(tdelay[i] * _fsamp + 0.5f));
+            _diff[i].init(k1);
+            _diff[i].c = (i & 1) ? -0.6f : 0.6f;
+            _delay[i].init(k2 - k1);
+            _filt[i].setParams(tdelay[i], rtmid, rtlow, wlo, 0.5f * rtmid, chi);
+            }
+      _pareq1.setfsamp(_fsamp);
+      _pareq2.setfsamp(_fsamp);
+      _pareq1.setparam(160.0, 0.0);
+      _pareq2.setparam(2.5e3, 0.0);
+      }
+
+//---------------------------------------------------------
+//   prepare
+//    output gains ramp to their targets over the first
+//    fragment and stay constant afterwards
+//---------------------------------------------------------
+
+void ReferenceReverb::prepare()
+      {
+      _d0 = _d1 = 0;
+      if (!_prepared) {
+            const float opmix = 0.33f;
+            const float rtmid = 2.0f;
+            float t0 = (1 - opmix) * (1 + opmix);
+            float t1 = 0.7f * opmix * (2 - opmix) / sqrtf(rtmid);
+            _d0 = (t0 - _g0) / FRAGMENT;
+            _d1 = (t1 - _g1) / FRAGMENT;
+            _prepared = true;
+            }
+      _pareq1.prepare(FRAGMENT);
+      _pareq2.prepare(FRAGMENT);
+      }
+
+//---------------------------------------------------------
+//   process
+//---------------------------------------------------------
+
+void ReferenceReverb::process(int nfram, const float* inp, float* out)
+      {
+      const float g = sqrtf(0.125f);
+      while (nfram) {
+            if (!_nsamp) {
+                  prepare();
+                  _nsamp = FRAGMENT;
+                  }
+            int k = qMin(_nsamp, nfram);
+            for (int i = 0; i < k; ++i) {
+                  float x[8];
+                  _vdelay[0].write(inp[2 * i]);
+                  _vdelay[1].write(inp[2 * i + 1]);
+                  float t = 0.3f * _vdelay[0].readDelayed();
+                  x[0] = _diff[0].process(_delay[0].read() + t);
+                  x[1] = _diff[1].process(_delay[1].read() + t);
+                  x[2] = _diff[2].process(_delay[2].read() - t);
+                  x[3] = _diff[3].process(_delay[3].read() - t);
+                  t = 0.3f * _vdelay[1].readDelayed();
+                  x[4] = _diff[4].process(_delay[4].read() + t);
+                  x[5] = _diff[5].process(_delay[5].read() + t);
+                  x[6] = _diff[6].process(_delay[6].read() - t);
+                  x[7] = _diff[7].process(_delay[7].read() - t);
+
+                  // 8x8 Hadamard mix
+                  for (int step = 1; step < 8; step *= 2) {
+                        for (int j = 0; j < 8; ++j) {
+                              if (j & step)
+                                    continue;
+                              t = x[j] - x[j + step];
+                              x[j] += x[j + step];
+                              x[j + step] = t;
+                              }
+                        }
+
+                  _g1 += _d1;
+                  out[2 * i]     = _g1 * (x[1] + x[2]);
+                  out[2 * i + 1] = _g1 * (x[1] - x[2]);
+
+                  for (int j = 0; j < 8; ++j)
+                        _delay[j].write(_filt[j].process(g * x[j]));
+                  }
+            _pareq1.process(k, out);
+            _pareq2.process(k, out);
+            for (int i = 0; i < k; ++i) {
+                  *out++ += _g0 * *inp++;
+                  *out++ += _g0 * *inp++;
+                  _g0 += _d0;
+                  }
+            nfram  -= k;
+            _nsamp -= k;
+            }
+      }
+
+//---------------------------------------------------------
+//   TestZita
+//---------------------------------------------------------
+
+class TestZita : public QObject
+      {
+      Q_OBJECT
+
+      static const int FRAMES = 48000;
+      std::vector<float> input;
+
+      std::vector<float> render(int frames);
+
+   private slots:
+      void initTestCase();
+      void bufferSize_data();
+      void bufferSize();
+      void benchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//    one second of stereo noise bursts
+//---------------------------------------------------------
+
+void TestZita::initTestCase()
+      {
+      input.resize(2 * FRAMES);
+      quint32 seed = 1;
+      for (int i = 0; i < 2 * FRAMES; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            float v = float(seed >> 8) / float(1 << 24) - 0.5f;
+            input[i] = ((i / 4800) & 1) ? 0.0f : v;
+            }
+      }
+
+//---------------------------------------------------------
+//   render
+//    run the input through a fresh reverb in buffers of
+//    the given number of frames
+//---------------------------------------------------------
+
+std::vector<float> TestZita::render(int frames)
+      {
+      ZitaReverb reverb;
+      reverb.init(48000);
+      std::vector<float> out(2 * FRAMES);
+      for (int i = 0; i < FRAMES; i += frames) {
+            int n = qMin(frames, FRAMES - i);
+            reverb.process(n, input.data() + 2 * i, out.data() + 2 * i);
+            }
+      return out;
+      }
+
+//---------------------------------------------------------
+//   bufferSize
+//    the delay network is processed in blocks; for any host
+//    buffer size the output must match the sample by sample
+//    reference implementation
+//---------------------------------------------------------
+
+void TestZita::bufferSize_data()
+      {
+      QTest::addColumn<int>("frames");
+
+      QTest::newRow("1")    << 1;
+      QTest::newRow("37")   << 37;
+      QTest::newRow("256")  << 256;
+      QTest::newRow("512")  << 512;
+      QTest::newRow("4096") << 4096;
+      }
+
+void TestZita::bufferSize()
+      {
+      QFETCH(int, frames);
+      static std::vector<float> reference;
+      if (reference.empty()) {
+            ReferenceReverb reverb(48000);
+            reference.resize(2 * FRAMES);
+            reverb.process(FRAMES, input.data(), reference.data());
+            }
+      std::vector<float> out = render(frames);
+
+      float peak = 0.0f;
+      for (float v : reference)
+            peak = qMax(peak, qAbs(v));
+      QVERIFY(peak > 0.01f && peak < 10.0f);
+
+      float maxDiff = 0.0f;
+      for (int i = 0; i < 2 * FRAMES; ++i)
+            maxDiff = qMax(maxDiff, qAbs(out[i] - reference[i]));
+      QVERIFY2(maxDiff <= 1e-6f * peak, qPrintable(QString("max difference %1, peak %2").arg(maxDiff).arg(peak)));
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    cost of one 512 frame buffer at 48 kHz
+//---------------------------------------------------------
+
+void TestZita::benchmark()
+      {
+      ZitaReverb reverb;
+      reverb.init(48000);
+      std::vector<float> out(2 * 512);
+      int pos = 0;
+      QBENCHMARK {
+            reverb.process(512, input.data() + 2 * pos, out.data());
+            pos = (pos + 512) % (FRAMES - 512);
+            }
+      }
+
+QTEST_MAIN(TestZita)
+#include "tst_zita.moc"
@@ -2,6 +2,7 @@
 #define INNER_FUNC_DECL_H
 
 #include <set>
+#include <functional>
 
 
 namespace Ms {
@@ -30,6 +31,25 @@ void splitFirstTupletChords(std::vector<TupletInfo> &tuplets,
 std::set<int> findLongestUncommonGroup(const std::vector<TupletInfo> &tuplets,
                                        const ReducedFraction &basicQuant);
 
+size_t selectTuplets(std::vector<TupletInfo> &tuplets,
+                     const ReducedFraction &basicQuant);
+
+std::vector<int> findBestTupletIndexes(const std::vector<TupletInfo> &tuplets,
+                                       const ReducedFraction &basicQuant,
+                                       size_t &searchSteps);
+
+std::vector<int> findCappedBestTupletIndexes(const std::vector<TupletInfo> &tuplets,
+                                             const ReducedFraction &basicQuant,
+                                             size_t &searchSteps);
+
+bool isTupletSelectionBetter(const std::vector<int> &tupletIndexes,
+                             const std::vector<int> &otherTupletIndexes,
+                             const std::vector<TupletInfo> &tuplets,
+                             const ReducedFraction &basicQuant);
+
+void setTupletCandidatesObserver(
+            const std::function<void(const std::vector<TupletInfo> &, const ReducedFraction &)> &observer);
+
 } // namespace MidiTuplet
 
 namespace Meter {
@@ -176,6 +176,8 @@ class TestImportMidi : public QObject, public MTest
       void findTupletApproximation();
       void separateTupletVoices();
       void findLongestUncommonGroup();
+      void filterManyTuplets();
+      void selectTupletsOnTestFiles();
 
       // metric bar analysis
       void metricDivisionsOfTuplet();
@@ -952,6 +954,155 @@ void TestImportMidi::separateTupletVoices()
       }
 
 
+// bar of pairs of conflicting tuplets: an exact triplet and a duplet with a big error
+// that shares the first chord of the triplet; the best selection takes all triplets
+
+std::vector<MidiTuplet::TupletInfo> conflictingTupletPairs(
+            std::multimap<ReducedFraction, MidiChord> &chords,
+            int pairCount)
+      {
+      const ReducedFraction beatLen = ReducedFraction::fromTicks(MScore::division);
+      const ReducedFraction noteLen = beatLen / 6;
+
+      auto tupletFactory = [&](const ReducedFraction &onTime, int tupletNumber,
+                               const ReducedFraction &sumError) {
+            MidiTuplet::TupletInfo info;
+            info.id = 0;
+            info.onTime = onTime;
+            info.len = beatLen;
+            info.tupletNumber = tupletNumber;
+            info.firstChordIndex = 0;
+            info.tupletSumError = sumError;
+            info.regularSumError = ReducedFraction(0, 1);
+            info.sumLengthOfRests = ReducedFraction(0, 1);
+            for (int i = 0; i != tupletNumber; ++i) {
+                  const auto chordOnTime = onTime + beatLen * i / tupletNumber;
+                  info.chords.insert({chordOnTime, chords.find(chordOnTime)});
+                  }
+            return info;
+            };
+
+      std::vector<MidiTuplet::TupletInfo> tuplets;
+      for (int i = 0; i != pairCount; ++i) {
+                        // pairs are two beats apart, so they never need a second voice
+            const ReducedFraction onTime = beatLen * 2 * i;
+            for (const auto &t: {ReducedFraction(0, 1), beatLen / 3, beatLen / 2, beatLen * 2 / 3})
+                  chords.insert({onTime + t, chordFactory(onTime + t + noteLen, {60 + i % 12})});
+            tuplets.push_back(tupletFactory(onTime, 3, ReducedFraction(0, 1)));
+            tuplets.push_back(tupletFactory(onTime, 2, beatLen));
+            }
+      for (int i = 0; i != (int)tuplets.size(); ++i)
+            tuplets[i].id = i;
+      return tuplets;
+      }
+
+void checkConflictingTupletSelection(const std::vector<MidiTuplet::TupletInfo> &tuplets,
+                                     int pairCount)
+      {
+      QCOMPARE((int)tuplets.size(), pairCount);
+      std::set<ReducedFraction> onTimes;
+      std::set<const MidiChord *> usedChords;
+      for (const auto &tuplet: tuplets) {
+            QCOMPARE(tuplet.tupletNumber, 3);
+            onTimes.insert(tuplet.onTime);
+                        // selected tuplets should not share chords
+            for (const auto &chord: tuplet.chords) {
+                  QVERIFY(usedChords.find(&chord.second->second) == usedChords.end());
+                  usedChords.insert(&chord.second->second);
+                  }
+            }
+      QCOMPARE((int)onTimes.size(), pairCount);
+      }
+
+void TestImportMidi::filterManyTuplets()
+      {
+      auto &opers = midiImportOperations;
+      const QString fileName("filter_many_tuplets");
+      opers.addNewMidiFile(fileName);
+      MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, fileName);
+      MidiOperations::CurrentTrackSetter setCurrentTrack{opers, 0};
+
+      const ReducedFraction basicQuant = ReducedFraction::fromTicks(MScore::division) / 4;
+
+                  // 12 candidates: all combinations are tried
+      {
+      std::multimap<ReducedFraction, MidiChord> chords;
+      auto tuplets = conflictingTupletPairs(chords, 6);
+      const size_t steps = MidiTuplet::selectTuplets(tuplets, basicQuant);
+      QVERIFY(steps > 0);
+      checkConflictingTupletSelection(tuplets, 6);
+      }
+                  // 26 candidates with 3^13 compatible subsets: the search skips
+                  // every selection with a duplet or without a triplet,
+                  // so it visits each candidate at most once per triplet;
+                  // capping the candidates by their error keeps
+                  // only one of the equally good triplets
+      {
+      std::multimap<ReducedFraction, MidiChord> chords;
+      auto tuplets = conflictingTupletPairs(chords, 13);
+      QCOMPARE((int)tuplets.size(), 26);
+
+      size_t steps = 0;
+      const auto indexes = MidiTuplet::findBestTupletIndexes(tuplets, basicQuant, steps);
+      QVERIFY(steps > 0 && steps < 26 * 26);
+      size_t cappedSteps = 0;
+      const auto cappedIndexes = MidiTuplet::findCappedBestTupletIndexes(
+                                                tuplets, basicQuant, cappedSteps);
+      QCOMPARE((int)cappedIndexes.size(), 1);
+      QVERIFY(MidiTuplet::isTupletSelectionBetter(indexes, cappedIndexes, tuplets, basicQuant));
+
+      MidiTuplet::selectTuplets(tuplets, basicQuant);
+      checkConflictingTupletSelection(tuplets, 13);
+      }
+
+      opers.excludeMidiFile(fileName);
+      }
+
+// compare the selected tuplets with the capped search that was used before:
+// import every test file and check that the capped selection
+// is never better for the tuplet candidates of any bar
+
+void TestImportMidi::selectTupletsOnTestFiles()
+      {
+      QString fileName;
+      int candidateSetCount = 0;
+      QStringList worseSelections;
+      MidiTuplet::setTupletCandidatesObserver(
+                  [&](const std::vector<MidiTuplet::TupletInfo> &tuplets,
+                      const ReducedFraction &basicQuant) {
+            if (tuplets.empty())
+                  return;
+            ++candidateSetCount;
+            size_t steps = 0;
+            const auto indexes = MidiTuplet::findBestTupletIndexes(tuplets, basicQuant, steps);
+            const auto cappedIndexes = MidiTuplet::findCappedBestTupletIndexes(
+                                                      tuplets, basicQuant, steps);
+            if (MidiTuplet::isTupletSelectionBetter(cappedIndexes, indexes, tuplets, basicQuant)) {
+                  worseSelections.append(QString("%1: %2 candidates")
+                                         .arg(fileName).arg(tuplets.size()));
+                  }
+            });
+
+      QStringList failedFiles;
+      const QDir dir(TESTROOT "/mtest/" + DIR);
+      for (const QString &file: dir.entryList(QStringList("*.mid"), QDir::Files)) {
+            fileName = QFileInfo(file).completeBaseName();
+            auto &opers = midiImportOperations;
+            opers.addNewMidiFile(midiFilePath(fileName));
+            MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, midiFilePath(fileName));
+
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            if (importMidi(score, midiFilePath(fileName)) != Score::FileError::FILE_NO_ERROR)
+                  failedFiles.append(fileName);
+            delete score;
+            }
+      MidiTuplet::setTupletCandidatesObserver(nullptr);
+
+      QVERIFY2(failedFiles.isEmpty(), qPrintable(failedFiles.join(", ")));
+      QVERIFY(candidateSetCount > 0);
+      QVERIFY2(worseSelections.isEmpty(), qPrintable(worseSelections.join(", ")));
+      }
+
 //---------------------------------------------------------
 //  metric bar analysis
 //---------------------------------------------------------
@@ -33,6 +33,7 @@ class TestCopyPaste : public QObject, public MTest
       Q_OBJECT
 
       void copypaste(const char*);
+      void copypasteclone(const char*);
       void copypastestaff(const char*);
       void copypastevoice(const char*, int);
       void copypastetuplet(const char*);
@@ -69,6 +70,15 @@ class TestCopyPaste : public QObject, public MTest
 
       void copyPastePartial();
 
+      void copypasteClone01() { copypasteclone("01"); }     // start slur
+      void copypasteClone03() { copypasteclone("03"); }     // slur
+      void copypasteClone06() { copypasteclone("06"); }     // tie
+      void copypasteClone09() { copypasteclone("09"); }     // ottava
+      void copypasteClone11() { copypasteclone("11"); }     // grace notes
+      void copypasteClone12() { copypasteclone("12"); }     // voices
+      void copypasteClone19() { copypasteclone("19"); }     // chord symbols
+      void copypasteClone23() { copypasteclone("23"); }     // full measure tuplet 10/8
+
       void copyPasteTuplet01() { copypastetuplet("01"); }
       void copyPasteTuplet02() { copypastetuplet("02"); }
       };
@@ -122,6 +132,38 @@ void TestCopyPaste::copypaste(const char* idx)
       delete score;
       }
 
+//---------------------------------------------------------
+//   copypasteclone
+//    copy measure 2, paste into measure 4 from the clones
+//    made at copy time instead of the xml
+//---------------------------------------------------------
+
+void TestCopyPaste::copypasteclone(const char* idx)
+      {
+      MasterScore* score = readScore(DIR + QString("copypaste%1.mscx").arg(idx));
+      Measure* m2 = score->firstMeasure()->nextMeasure();    // src
+      Measure* m4 = m2->nextMeasure()->nextMeasure();        // dst
+
+      score->select(m2);
+      if (score->nstaves() > 1)
+            score->select(m2, SelectType::RANGE, score->nstaves() - 1);
+      QVERIFY(score->selection().canCopy());
+      QMimeData* mimeData = score->selection().createMimeData();
+      StaffListMimeData* staffListData = qobject_cast<StaffListMimeData*>(mimeData);
+      QVERIFY(staffListData && staffListData->staffList());
+      QVERIFY(mimeData->hasFormat(mimeStaffListFormat));     // xml for other applications
+      QApplication::clipboard()->setMimeData(mimeData);
+      score->select(m4->first()->element(0));
+
+      score->startCmd();
+      score->cmdPaste(mimeData, 0);
+      score->endCmd();
+
+      QVERIFY(saveCompareScore(score, QString("copypasteclone%1.mscx").arg(idx),
+         DIR + QString("copypaste%1-ref.mscx").arg(idx)));
+      delete score;
+      }
+
 //---------------------------------------------------------
 //   copypaste
 //    copy measure 2 from first staff, paste into staff 2
@@ -30,11 +30,12 @@ class TestBenchmark : public QObject, public MTest
       {
       Q_OBJECT
 
-      MasterScore* score;
+      MasterScore* score { 0 };
       void beam(const char* path);
 
    private slots:
       void initTestCase();
+      void benchmark3_data();
       void benchmark3();
       void benchmark1();
       void benchmark2();
@@ -52,11 +53,23 @@ void TestBenchmark::initTestCase()
 
 //---------------------------------------------------------
 //   benchmark
+//    load time; the last score is used by the layout
+//    benchmarks below
 //---------------------------------------------------------
 
+void TestBenchmark::benchmark3_data()
+      {
+      QTest::addColumn<QString>("file");
+
+      QTest::newRow("orchestral") << QString("libmscore/concertpitch/concertpitchbenchmark.mscx");
+      QTest::newRow("goldberg")   << QString("../demos/goldberg.mscz");
+      }
+
 void TestBenchmark::benchmark3()
       {
-      QString path = root + "/" + DIR + "goldberg.mscx";
+      QFETCH(QString, file);
+      QString path = root + "/" + file;
+      delete score;
       score = new MasterScore(mscore->baseStyle());
       score->setName(path);
       MScore::testMode = true;
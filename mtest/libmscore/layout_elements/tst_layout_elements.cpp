@@ -13,6 +13,7 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/measure.h"
+#include "libmscore/mscore.h"
 #include "libmscore/page.h"
 #include "libmscore/score.h"
 #include "libmscore/staff.h"
@@ -40,6 +41,7 @@ class TestLayoutElements : public QObject, public MTest
       void tstLayoutElements()  { tstLayoutAll("layout_elements.mscx"); }
       void tstLayoutTablature() { tstLayoutAll("layout_elements_tab.mscx"); }
       void tstLayoutMoonlight() { tstLayoutAll("moonlight.mscx");       }
+      void tstDrawParallel();
       // FIXME goldberg.mscx does not pass the test because of some
       // TimeSig and Clef elements. Need to check it later!
 //       void tstLayoutGoldberg()  { tstLayoutAll("goldberg.mscx");        }
@@ -113,6 +115,89 @@ void TestLayoutElements::tstLayoutAll(QString file)
             }
       }
 
+//---------------------------------------------------------
+//   renderPage
+//    draw the elements of a page into a png,
+//    like MuseScore::savePng does
+//---------------------------------------------------------
+
+static const double convDpi = 150.0;
+
+static QByteArray renderPage(Page* page, const QList<Element*>& elements)
+      {
+      QRectF r = page->abbox();
+      QImage image(lrint(r.width() * convDpi / DPI), lrint(r.height() * convDpi / DPI), QImage::Format_ARGB32_Premultiplied);
+      image.fill(0xffffffff);
+      QPainter p(&image);
+      p.setRenderHint(QPainter::Antialiasing, true);
+      p.setRenderHint(QPainter::TextAntialiasing, true);
+      p.scale(convDpi / DPI, convDpi / DPI);
+      for (const Element* e : elements) {
+            if (!e->visible())
+                  continue;
+            QPointF pos(e->pagePos());
+            p.translate(pos);
+            e->draw(&p);
+            p.translate(-pos);
+            }
+      p.end();
+
+      QByteArray png;
+      QBuffer buffer(&png);
+      buffer.open(QIODevice::WriteOnly);
+      image.save(&buffer, "png");
+      return png;
+      }
+
+//---------------------------------------------------------
+//   tstDrawParallel
+//    The pages of a png export are drawn concurrently.
+//    Every page of a score with tablature and an image is
+//    drawn several times at once on a freshly read score,
+//    so the lazily filled caches are hit from several
+//    threads, then once more serially: the results must
+//    be identical.
+//---------------------------------------------------------
+
+void TestLayoutElements::tstDrawParallel()
+      {
+      MasterScore* score = readScore(DIR + "draw_tab_image.mscx");
+      QVERIFY(score);
+      const QList<Page*>& pages = score->pages();
+      QVERIFY(pages.size() > 1);
+
+      score->setPrinting(true);
+      double pr = MScore::pixelRatio;
+      MScore::pixelRatio = DPI / convDpi;
+
+      struct PageJob {
+            Page* page;
+            QList<Element*> elements;
+            QByteArray png;
+            };
+      const int copies = 4;
+      QVector<PageJob> jobs;
+      for (int i = 0; i < copies; ++i) {
+            for (Page* page : pages) {
+                  QList<Element*> el = page->elements();
+                  qStableSort(el.begin(), el.end(), elementLessThan);
+                  jobs.append({ page, el, QByteArray() });
+                  }
+            }
+      QtConcurrent::blockingMap(jobs, [](PageJob& job) { job.png = renderPage(job.page, job.elements); });
+
+      for (int i = 0; i < pages.size(); ++i) {
+            QByteArray serial = renderPage(jobs[i].page, jobs[i].elements);
+            QVERIFY(!serial.isEmpty());
+            for (int k = 0; k < copies; ++k)
+                  QVERIFY(jobs[k * pages.size() + i].png == serial);
+            }
+
+      MScore::pixelRatio = pr;
+      score->setPrinting(false);
+      delete score;
+      }
+
 QTEST_MAIN(TestLayoutElements)
 #include "tst_layout_elements.moc"
 
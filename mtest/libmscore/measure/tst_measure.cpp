@@ -57,6 +57,7 @@ class TestMeasure : public QObject, public MTest
 //      void minWidth();
       void undoDelInitialVBox_269919();
       void mmrest();
+      void tick2measure();
 
       void gap();
       void checkMeasure();
@@ -522,6 +523,63 @@ void TestMeasure::mmrest()
       delete score;
       }
 
+//---------------------------------------------------------
+//   checkTick2measure
+//    every tick of every measure must map back to it
+//---------------------------------------------------------
+
+static void checkTick2measure(Score* score)
+      {
+      for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            QCOMPARE(score->tick2measure(m->tick()), m);
+            QCOMPARE(score->tick2measure(m->endTick() - Fraction(1, 480)), m);
+            QCOMPARE(score->tick2measureBase(m->tick()), static_cast<MeasureBase*>(m));
+            }
+      for (Measure* m = score->firstMeasureMM(); m; m = m->nextMeasureMM()) {
+            QCOMPARE(score->tick2measureMM(m->tick()), m);
+            QCOMPARE(score->tick2measureMM(m->endTick() - Fraction(1, 480)), m);
+            }
+      QCOMPARE(score->tick2measure(score->lastMeasure()->endTick()), score->lastMeasure());
+      QVERIFY(!score->tick2measure(score->lastMeasure()->endTick() + Fraction(1, 4)));
+      }
+
+//---------------------------------------------------------
+///   tick2measure
+///    measure lookup stays correct across edits and undo
+//---------------------------------------------------------
+
+void TestMeasure::tick2measure()
+      {
+      MasterScore* score = readScore(DIR + "measure-1.mscx");
+      checkTick2measure(score);
+
+      score->startCmd();
+      score->insertMeasure(ElementType::MEASURE, score->firstMeasure()->nextMeasure());
+      score->endCmd();
+      checkTick2measure(score);
+
+      score->startCmd();
+      score->insertMeasure(ElementType::MEASURE, 0);
+      score->endCmd();
+      checkTick2measure(score);
+
+      score->undoRedo(true, 0);
+      checkTick2measure(score);
+      score->undoRedo(true, 0);
+      checkTick2measure(score);
+      delete score;
+
+      score = readScore(DIR + "mmrest.mscx");
+      checkTick2measure(score);
+      score->startCmd();
+      score->undo(new ChangeStyleVal(score, Sid::createMultiMeasureRests, true));
+      score->setLayoutAll();
+      score->endCmd();
+      checkTick2measure(score);
+      score->undoRedo(true, 0);
+      checkTick2measure(score);
+      delete score;
+      }
 
 QTEST_MAIN(TestMeasure)
 
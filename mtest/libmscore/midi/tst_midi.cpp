@@ -22,6 +22,8 @@
 #include "libmscore/chord.h"
 #include "libmscore/note.h"
 #include "libmscore/keysig.h"
+#include "libmscore/rendermidi.h"
+#include "synthesizer/event.h"
 #include "mscore/exportmidi.h"
 #include <QIODevice>
 
@@ -70,6 +72,7 @@ class TestMidi : public QObject, public MTest
           }
       void midiTimeStretchFermata();
       void midiSingleNoteDynamics();
+      void midiIncrementalRender();
       };
 
 //---------------------------------------------------------
@@ -411,6 +414,93 @@ void TestMidi::midiSingleNoteDynamics()
       delete score;
       }
 
+//---------------------------------------------------------
+//   renderMissingChunks
+//    render all chunks which are not marked in status
+//---------------------------------------------------------
+
+static void renderMissingChunks(MidiRenderer& renderer, EventMap* events, RangeMap* status, const SynthesizerState& ss)
+      {
+      int utick = 0;
+      while (MidiRenderer::Chunk chunk = renderer.getChunkAt(utick)) {
+            if (status->occupiedRangeEnd(chunk.utick1()) == chunk.utick1()) {
+                  renderer.renderChunk(chunk, events, ss);
+                  status->setOccupied(chunk.utick1(), chunk.utick2());
+                  }
+            utick = chunk.utick2();
+            }
+      }
+
+//---------------------------------------------------------
+//   eventList
+//    events as sorted strings, independent of the order
+//    of events on the same tick
+//---------------------------------------------------------
+
+static QStringList eventList(const EventMap& events)
+      {
+      QStringList l;
+      for (const auto& e : events) {
+            l.append(QString("%1 %2 %3 %4 %5").arg(e.first).arg(e.second.type())
+               .arg(e.second.dataA()).arg(e.second.dataB()).arg(e.second.channel()));
+            }
+      l.sort();
+      return l;
+      }
+
+//---------------------------------------------------------
+//   midiIncrementalRender
+//    changing a note renders only the chunks around it
+//    again, the result must match a complete rendering
+//---------------------------------------------------------
+
+void TestMidi::midiIncrementalRender()
+      {
+      MasterScore* score = readScore(DIR + "testAndanteExcerpts.mscx");
+      QVERIFY(score);
+      score->doLayout();
+
+      SynthesizerState ss;
+      MidiRenderer renderer(score);
+      renderer.setMinChunkSize(2);
+      EventMap events;
+      RangeMap status;
+      renderMissingChunks(renderer, &events, &status, ss);
+
+      Measure* m = score->firstMeasure();
+      for (int i = 0; i < 20 && m->nextMeasure(); ++i)
+            m = m->nextMeasure();
+      Chord* chord = nullptr;
+      for (Segment* s = m->first(SegmentType::ChordRest); s && !chord; s = s->next(SegmentType::ChordRest)) {
+            if (s->element(0) && s->element(0)->isChord())
+                  chord = toChord(s->element(0));
+            }
+      QVERIFY(chord);
+      Note* note = chord->upNote();
+
+      score->startCmd();
+      note->undoChangeProperty(Pid::PITCH, note->pitch() + 1);
+      score->endCmd();
+      QVERIFY(score->playlistDirty());
+      QVERIFY(!score->playlistDirtyAll());
+
+      int rendered = 0;
+      for (const std::pair<int, int>& r : renderer.setScoreChanged(score->playlistDirtyTick1().ticks(), score->playlistDirtyTick2().ticks())) {
+            events.eraseRange(r.first, r.second);
+            status.setUnoccupied(r.first, r.second);
+            rendered += r.second - r.first;
+            }
+      QVERIFY(rendered > 0);
+      QVERIFY(rendered < score->lastMeasure()->endTick().ticks() / 2);
+      renderMissingChunks(renderer, &events, &status, ss);
+
+      EventMap reference;
+      MidiRenderer(score).renderScore(&reference, ss);
+      QCOMPARE(eventList(events), eventList(reference));
+
+      delete score;
+      }
+
 //---------------------------------------------------------
 //   events
 //---------------------------------------------------------
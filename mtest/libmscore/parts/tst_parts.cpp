@@ -61,6 +61,7 @@ class TestParts : public QObject, public MTest
 
       void createPart1();
       void createPart2();
+      void createPartsBulk();
       void voicesExcerpt();
 
       void createPartBreath();
@@ -173,6 +174,45 @@ void TestParts::createParts(MasterScore* score)
       score->setExcerptsChanged(true);
       }
 
+//---------------------------------------------------------
+//   createPartsBulk
+//    all parts created in one command, undone at once
+//---------------------------------------------------------
+
+void TestParts::createPartsBulk()
+      {
+      MasterScore* score = readScore(DIR + "part-all.mscx");
+      QVERIFY(score);
+
+      QList<Excerpt*> excerpts = Excerpt::createAllExcerpt(score);
+      QCOMPARE(excerpts.size(), score->parts().size());
+      Excerpt::createExcerpts(score, excerpts, true);
+
+      QCOMPARE(score->excerpts().size(), excerpts.size());
+      for (Excerpt* e : score->excerpts()) {
+            Score* nscore = e->partScore();
+            QVERIFY(nscore);
+            QVERIFY(!nscore->pages().isEmpty());
+            for (Staff* staff : nscore->staves())
+                  QVERIFY(staff->links());
+            // every part of the score has one staff
+            QCOMPARE(e->parts().size(), 1);
+            QCOMPARE(e->tracks().size(), VOICES);
+            }
+
+      // the tracks map all voices of the parts, no track list is written
+      QVERIFY(saveScore(score, "part-bulk.mscx"));
+      QFile f("part-bulk.mscx");
+      QVERIFY(f.open(QIODevice::ReadOnly));
+      QByteArray data = f.readAll();
+      QVERIFY(!data.isEmpty());
+      QVERIFY(!data.contains("<Tracklist"));
+
+      score->undoRedo(true, 0);
+      QVERIFY(score->excerpts().isEmpty());
+      delete score;
+      }
+
 //---------------------------------------------------------
 //   voicesExcerpt
 //---------------------------------------------------------
@@ -0,0 +1,85 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2019 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+
+#define DIR QString("omr/notes/")
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestOmrBenchmark
+//---------------------------------------------------------
+
+class TestOmrBenchmark : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      void recognize(const QString& file);
+
+   private slots:
+      void initTestCase();
+      void benchmark_data();
+      void benchmark();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestOmrBenchmark::initTestCase()
+      {
+      initMTest();
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//    render the test scores to pdf and time the
+//    recognition of the resulting pages
+//---------------------------------------------------------
+
+void TestOmrBenchmark::benchmark_data()
+      {
+      QTest::addColumn<QString>("file");
+      QTest::newRow("notes1") << "notes1";
+      QTest::newRow("notes2") << "notes2";
+      }
+
+void TestOmrBenchmark::benchmark()
+      {
+      QFETCH(QString, file);
+      MasterScore* score = readScore(DIR + file + ".mscx");
+      QVERIFY(score);
+      score->doLayout();
+      const int pages = score->npages();
+      QVERIFY(savePdf(score, file + ".pdf"));
+      delete score;
+
+      QElapsedTimer timer;
+      qint64 elapsed = 0;
+      int runs = 0;
+      QBENCHMARK {
+            timer.start();
+            Score* score1 = readCreatedScore(file + ".pdf");
+            elapsed += timer.elapsed();
+            ++runs;
+            QVERIFY(score1);
+            delete score1;
+            }
+      qDebug("%s: %d page(s), %.1f ms per page", qPrintable(file), pages,
+         double(elapsed) / (runs * qMax(pages, 1)));
+      }
+
+QTEST_MAIN(TestOmrBenchmark)
+#include "tst_omrbenchmark.moc"
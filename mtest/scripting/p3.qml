@@ -0,0 +1,35 @@
+import QtQuick 2.0
+import MuseScore 3.0
+
+MuseScore {
+      menuPath: "Plugins.p3"
+      onRun: {
+            openLog("p3.log");
+            logn("test script p3: bulk note access")
+
+            var notes = curScore.notes();
+            log2("notes:", notes.length);
+            for (var i = 0; i < notes.length; i++)
+                  log2("  pitch:", notes[i].pitch);
+            log2("same wrapper:", notes[0] === curScore.notes()[0]);
+
+            var cursor = curScore.newCursor();
+            cursor.rewind(0);
+            var first = cursor.segment;
+            cursor.next();
+            cursor.next();
+            var last = cursor.segment;
+
+            var head = curScore.notes(first, last);
+            log2("notes before tick " + last.tick + ":", head.length);
+            for (var i = 0; i < head.length; i++)
+                  log2("  pitch:", head[i].pitch);
+
+            var tail = curScore.notes(last);
+            log2("notes from tick " + last.tick + ":", tail.length);
+            for (var i = 0; i < tail.length; i++)
+                  log2("  pitch:", tail[i].pitch);
+            closeLog();
+            Qt.quit()
+            }
+      }
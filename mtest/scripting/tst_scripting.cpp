@@ -42,6 +42,7 @@ class TestScripting : public QObject, public MTest
       void plugins01();
       void plugins02();
       void test1() { read1("s1", "p1"); }       // scan note rest
+      void test3() { read1("s1", "p3"); }       // bulk note access, Score.notes()
 #if 0
       void test2() { read1("s2", "p2"); }       // scan segment attributes
       void testTextStyle();
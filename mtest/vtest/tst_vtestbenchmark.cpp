@@ -0,0 +1,196 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestVtestBenchmark
+//    Times reading, layout, a warm relayout and painting
+//    the first page of every vtest score and of some large
+//    real world scores.
+//
+//    The timings are written as JSON to the file named by
+//    MSCORE_BENCHMARK_OUTPUT, if it is set.
+//    If MSCORE_BENCHMARK_BASELINE names such a file from an
+//    earlier run, a score fails when one of its phases got
+//    slower than the baseline by more than the factor in
+//    MSCORE_BENCHMARK_TOLERANCE (default 1.25).
+//---------------------------------------------------------
+
+class TestVtestBenchmark : public QObject, public MTest
+      {
+      Q_OBJECT
+
+      static const int REPEAT = 3;        // the fastest of these runs counts
+      static constexpr double MIN_DIFF = 2.0;   // ms, ignore smaller differences as noise
+      static constexpr double PAINT_DPI = 130.0; // as used by vtest/gen
+
+      QJsonObject _results;
+      QJsonObject _baseline;
+      double _tolerance { 1.25 };
+
+   private slots:
+      void initTestCase();
+      void benchmark_data();
+      void benchmark();
+      void cleanupTestCase();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestVtestBenchmark::initTestCase()
+      {
+      initMTest();
+      MScore::testMode = true;
+
+      QByteArray tolerance = qgetenv("MSCORE_BENCHMARK_TOLERANCE");
+      if (!tolerance.isEmpty())
+            _tolerance = tolerance.toDouble();
+
+      QString baseline = QString::fromLocal8Bit(qgetenv("MSCORE_BENCHMARK_BASELINE"));
+      if (!baseline.isEmpty()) {
+            QFile f(baseline);
+            QVERIFY2(f.open(QIODevice::ReadOnly), qPrintable(QString("cannot read baseline <%1>").arg(baseline)));
+            _baseline = QJsonDocument::fromJson(f.readAll()).object().value("scores").toObject();
+            QVERIFY2(!_baseline.isEmpty(), qPrintable(QString("no timings in baseline <%1>").arg(baseline)));
+            }
+      }
+
+//---------------------------------------------------------
+//   benchmark
+//---------------------------------------------------------
+
+void TestVtestBenchmark::benchmark_data()
+      {
+      QTest::addColumn<QString>("file");
+
+      QDir vtest(root + "/../vtest");
+      for (const QString& s : vtest.entryList(QStringList("*.mscx"), QDir::Files, QDir::Name))
+            QTest::newRow(qPrintable(QFileInfo(s).completeBaseName())) << vtest.filePath(s);
+
+      QTest::newRow("orchestral")       << root + "/libmscore/concertpitch/concertpitchbenchmark.mscx";
+      QTest::newRow("goldberg")         << root + "/../demos/goldberg.mscz";
+      QTest::newRow("Fugue_1")          << root + "/../demos/Fugue_1.mscx";
+      QTest::newRow("Brassed_Up")       << root + "/../demos/Brassed_Up.mscx";
+      QTest::newRow("Dynamic_Strings")  << root + "/../demos/Dynamic_Strings.mscx";
+      }
+
+void TestVtestBenchmark::benchmark()
+      {
+      QFETCH(QString, file);
+
+      QFile f(file);
+      QVERIFY2(f.open(QIODevice::ReadOnly), qPrintable(file));
+      QByteArray data = f.readAll();
+
+      qint64 best[4] = { -1, -1, -1, -1 };
+      int pages = 0;
+      QElapsedTimer timer;
+      for (int i = 0; i < REPEAT; ++i) {
+            qint64 t[4];
+            QBuffer buffer(&data);
+            buffer.open(QIODevice::ReadOnly);
+            MasterScore* s = new MasterScore(mscore->baseStyle());
+            s->setName(QFileInfo(file).completeBaseName());
+
+            timer.start();
+            Score::FileError rv = s->loadMsc(file, &buffer, true);
+            t[0] = timer.nsecsElapsed();
+            if (rv != Score::FileError::FILE_NO_ERROR) {
+                  delete s;
+                  QFAIL(qPrintable(QString("cannot read <%1>").arg(file)));
+                  }
+
+            timer.start();
+            s->doLayout();
+            t[1] = timer.nsecsElapsed();
+
+            timer.start();
+            s->doLayout();
+            t[2] = timer.nsecsElapsed();
+
+            pages = s->pages().size();
+            t[3] = 0;
+            if (pages) {
+                  QRectF r = s->pages().front()->abbox();
+                  double mag = PAINT_DPI / DPI;
+                  QImage image(lrint(r.width() * mag), lrint(r.height() * mag), QImage::Format_ARGB32_Premultiplied);
+                  image.fill(0xffffffff);
+                  double pr = MScore::pixelRatio;
+                  MScore::pixelRatio = DPI / PAINT_DPI;
+                  QPainter p(&image);
+                  p.setRenderHint(QPainter::Antialiasing, true);
+                  p.setRenderHint(QPainter::TextAntialiasing, true);
+                  p.scale(mag, mag);
+                  timer.start();
+                  s->print(&p, 0);
+                  p.end();
+                  t[3] = timer.nsecsElapsed();
+                  MScore::pixelRatio = pr;
+                  }
+            delete s;
+
+            for (int k = 0; k < 4; ++k) {
+                  if (best[k] < 0 || t[k] < best[k])
+                        best[k] = t[k];
+                  }
+            }
+
+      static const char* phases[4] = { "read", "layout", "relayout", "paint" };
+      const QString name = QTest::currentDataTag();
+      QJsonObject result;
+      QJsonObject base = _baseline.value(name).toObject();
+      QStringList regressions;
+      for (int k = 0; k < 4; ++k) {
+            double ms = best[k] / 1e6;
+            result.insert(phases[k], ms);
+            if (base.contains(phases[k])) {
+                  double b = base.value(phases[k]).toDouble();
+                  if (ms > b * _tolerance && ms - b > MIN_DIFF)
+                        regressions.append(QString("%1 %2 ms (baseline %3 ms)").arg(phases[k]).arg(ms, 0, 'f', 2).arg(b, 0, 'f', 2));
+                  }
+            }
+      result.insert("pages", pages);
+      _results.insert(name, result);
+
+      QVERIFY2(regressions.isEmpty(), qPrintable(QString("%1 got slower: %2").arg(name).arg(regressions.join(", "))));
+      }
+
+//---------------------------------------------------------
+//   cleanupTestCase
+//---------------------------------------------------------
+
+void TestVtestBenchmark::cleanupTestCase()
+      {
+      QString output = QString::fromLocal8Bit(qgetenv("MSCORE_BENCHMARK_OUTPUT"));
+      if (output.isEmpty())
+            return;
+
+      QJsonObject json;
+      json.insert("version", 1);
+      json.insert("repeat", REPEAT);
+      json.insert("unit", QString("ms"));
+      json.insert("scores", _results);
+
+      QFile f(output);
+      QVERIFY2(f.open(QIODevice::WriteOnly), qPrintable(QString("cannot write <%1>").arg(output)));
+      f.write(QJsonDocument(json).toJson());
+      }
+
+QTEST_MAIN(TestVtestBenchmark)
+#include "tst_vtestbenchmark.moc"
+
@@ -0,0 +1,264 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "mtest/testutils.h"
+
+#include "zerberus/instrument.h"
+#include "zerberus/zerberus.h"
+#include "zerberus/zone.h"
+#include "zerberus/sample.h"
+#include "zerberus/stream.h"
+#include "mscore/preferences.h"
+#include "synthesizer/event.h"
+
+using namespace Ms;
+
+static const int RING_FRAMES = 64;
+static const int READ_CHUNK  = 16;
+
+//---------------------------------------------------------
+//   TestSfzStreaming
+//    The same instrument is loaded once with its sample
+//    streamed after the first 32 frames and once
+//    completely; both have to sound the same. The sample
+//    is streamed through a ring of 64 frames, so it wraps
+//    several times.
+//---------------------------------------------------------
+
+class TestSfzStreaming : public QObject, public MTest
+      {
+      Q_OBJECT
+      float samplerate = 44100;
+      Zerberus* streamed;
+      Zerberus* realtime;
+      Zerberus* loaded;
+
+      void render(Zerberus*, int key, int frames, float* data, int block);
+
+   private slots:
+      void initTestCase();
+      void testStreamed();
+      void testStreamedAudio_data();
+      void testStreamedAudio();
+      void testRealtimeAudio_data();
+      void testRealtimeAudio();
+      void testRealtimeUnderrun();
+      void testStreamRing();
+   public:
+      ~TestSfzStreaming();
+      };
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSfzStreaming::initTestCase()
+      {
+      initMTest();
+      preferences.setPreference(PREF_APP_PATHS_MYSOUNDFONTS, root);
+
+      SampleStream::setRingSize(RING_FRAMES, READ_CHUNK);
+
+      preferences.setPreference(PREF_IO_ZERBERUS_STREAMSAMPLES, true);
+      preferences.setPreference(PREF_IO_ZERBERUS_PRELOADFRAMES, 32);
+      streamed = new Zerberus();
+      streamed->init(samplerate);
+      streamed->loadInstrument("streamTestStreamed.sfz");
+      streamed->setOffline(true);
+
+      // the instrument is shared, the streams are filled by the reader thread
+      realtime = new Zerberus();
+      realtime->init(samplerate);
+      realtime->loadInstrument("streamTestStreamed.sfz");
+
+      preferences.setPreference(PREF_IO_ZERBERUS_STREAMSAMPLES, false);
+      loaded = new Zerberus();
+      loaded->init(samplerate);
+      loaded->loadInstrument("streamTestLoaded.sfz");
+      }
+
+//---------------------------------------------------------
+//   render
+//    Before every block the reader thread, if any, is
+//    given the time to fill the streams.
+//---------------------------------------------------------
+
+void TestSfzStreaming::render(Zerberus* synth, int key, int frames, float* data, int block)
+      {
+      memset(data, 0, (frames + 64) * 2 * sizeof(float));
+      synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, 127));
+      for (int i = 0; i < frames; i += block) {
+            synth->waitForStreams();
+            synth->process(qMin(block, frames - i), data + i * 2, nullptr, nullptr);
+            }
+      synth->play(Ms::PlayEvent(ME_NOTEON, 0, key, 0));
+      synth->process(64, data + frames * 2, nullptr, nullptr);
+      }
+
+//---------------------------------------------------------
+//   testStreamed
+//---------------------------------------------------------
+
+void TestSfzStreaming::testStreamed()
+      {
+      for (Zone* z : streamed->instrument(0)->zones()) {
+            QVERIFY(z->sample->streamed());
+            QCOMPARE(z->sample->headFrames(), 32ll);
+            }
+      for (Zone* z : loaded->instrument(0)->zones())
+            QVERIFY(!z->sample->streamed());
+      }
+
+//---------------------------------------------------------
+//   testStreamedAudio
+//---------------------------------------------------------
+
+void TestSfzStreaming::testStreamedAudio_data()
+      {
+      QTest::addColumn<int>("key");
+      QTest::addColumn<int>("frames");
+
+      QTest::newRow("from start")          << 60 << 280;
+      QTest::newRow("octave up, offset")   << 72 << 120;
+      }
+
+void TestSfzStreaming::testStreamedAudio()
+      {
+      QFETCH(int, key);
+      QFETCH(int, frames);
+
+      std::vector<float> a((frames + 64) * 2);
+      std::vector<float> b((frames + 64) * 2);
+      render(streamed, key, frames, a.data(), frames);
+      render(loaded, key, frames, b.data(), frames);
+
+      float peak = 0.0;
+      for (int i = 0; i < frames * 2; ++i) {
+            QCOMPARE(a[i], b[i]);
+            peak = qMax(peak, qAbs(a[i]));
+            }
+      QVERIFY(peak > 0.0);
+      QCOMPARE(streamed->underruns(), 0);
+      }
+
+//---------------------------------------------------------
+//   testRealtimeAudio
+//    the reader thread fills the ring between the blocks
+//---------------------------------------------------------
+
+void TestSfzStreaming::testRealtimeAudio_data()
+      {
+      QTest::addColumn<int>("key");
+      QTest::addColumn<int>("frames");
+
+      QTest::newRow("from start")          << 60 << 280;
+      QTest::newRow("octave up, offset")   << 72 << 120;
+      }
+
+void TestSfzStreaming::testRealtimeAudio()
+      {
+      QFETCH(int, key);
+      QFETCH(int, frames);
+
+      const int block = 16;
+      int underruns = realtime->underruns();
+      std::vector<float> a((frames + 64) * 2);
+      std::vector<float> b((frames + 64) * 2);
+      render(realtime, key, frames, a.data(), block);
+      render(loaded, key, frames, b.data(), block);
+
+      float peak = 0.0;
+      for (int i = 0; i < frames * 2; ++i) {
+            QCOMPARE(a[i], b[i]);
+            peak = qMax(peak, qAbs(a[i]));
+            }
+      QVERIFY(peak > 0.0);
+      QCOMPARE(realtime->underruns(), underruns);
+      }
+
+//---------------------------------------------------------
+//   testRealtimeUnderrun
+//    In one block the voice runs past the ring, which is
+//    only refilled after the block. It must count the
+//    underrun and not wait for the reader.
+//---------------------------------------------------------
+
+void TestSfzStreaming::testRealtimeUnderrun()
+      {
+      const int frames = 280;
+      int underruns = realtime->underruns();
+      std::vector<float> a((frames + 64) * 2);
+      render(realtime, 60, frames, a.data(), frames);
+      QVERIFY(realtime->underruns() > underruns);
+      }
+
+//---------------------------------------------------------
+//   testStreamRing
+//    Stream the sample through the ring with the reader
+//    thread and compare it with the loaded sample. A frame
+//    which is not read yet is reported missing, never
+//    taken from the stale ring content of an earlier
+//    start. Past the end of the sample there is silence.
+//---------------------------------------------------------
+
+void TestSfzStreaming::testStreamRing()
+      {
+      const Sample* s   = streamed->instrument(0)->zones().front()->sample;
+      const Sample* ref = loaded->instrument(0)->zones().front()->sample;
+      QVERIFY(s->streamed());
+      const long long head = s->headFrames();
+
+      SampleStream stream;
+      StreamReader reader({ &stream });
+      reader.startReading();
+
+      short v;
+      for (int pass = 0; pass < 2; ++pass) {
+            stream.start(s, head);
+            for (long long frame = head; frame < s->frames(); ++frame) {
+                  if (!stream.value(frame, 0, v)) {
+                        stream.setReadFrame(frame);
+                        reader.waitIdle();
+                        QVERIFY(stream.value(frame, 0, v));
+                        }
+                  QCOMPARE(v, ref->data()[frame]);
+                  }
+            }
+
+      // the ring holds the end of the sample from the last pass
+      stream.start(s, head);
+      QVERIFY(!stream.value(head + RING_FRAMES, 0, v));
+      reader.waitIdle();
+      QVERIFY(stream.value(head, 0, v));
+      QCOMPARE(v, ref->data()[head]);
+      QVERIFY(!stream.value(head + RING_FRAMES, 0, v));
+
+      stream.setReadFrame(s->frames() - 8);
+      reader.waitIdle();
+      QVERIFY(stream.value(s->frames() + 8, 0, v));
+      QCOMPARE(v, short(0));
+
+      reader.stopStreams();
+      reader.stopReading();
+      }
+
+TestSfzStreaming::~TestSfzStreaming()
+      {
+      delete streamed;
+      delete realtime;
+      delete loaded;
+      }
+
+QTEST_MAIN(TestSfzStreaming)
+
+#include "tst_sfzstreaming.moc"
+
@@ -43,6 +43,7 @@ Pattern* Omr::naturalPattern;
 Pattern* Omr::trebleclefPattern;
 Pattern* Omr::bassclefPattern;
 Pattern* Omr::timesigPattern[10];
+bool Omr::parallel = true;
 
 //---------------------------------------------------------
 //   Omr
@@ -155,7 +156,12 @@ bool Omr::readPdf()
       int page = 0;
       bool val;
       while (ID < ACTION_NUM) {
-            if(ID != INIT_PAGE && ID != SYSTEM_IDENTIFICATION) {
+            if (parallel && (ID == INIT_PAGE || ID == SYSTEM_IDENTIFICATION)) {
+                  progress->setLabelText(ActionNames.at(ID));
+                  val = processPages(ID, progress);
+                  ID++;
+                  }
+            else if(ID != INIT_PAGE && ID != SYSTEM_IDENTIFICATION) {
                   page = 0;
                   progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID+1)).arg(1));
                   val = omrActions(ID, page);
@@ -212,16 +218,7 @@ bool Omr::omrActions(int &ID, int page)
             return true;
             }
       else if(ID == INIT_PAGE) {
-            //load one page and rescale
-            _pages[page]->read();
-
-            //do the rescaling here
-            int new_w = _pages[page]->image().width() * _spatium/_pages[page]->spatium();
-            int new_h = _pages[page]->image().height() * _spatium/_pages[page]->spatium();
-            QImage image = _pages[page]->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
-            _pages[page]->setImage(image);
-            _pages[page]->read();
-
+            initPage(_pages[page]);
             if(page == _pages.size()-1)
                   ID++;
             return true;
@@ -265,6 +262,52 @@ bool Omr::omrActions(int &ID, int page)
       return false;
       }
 
+//---------------------------------------------------------
+//   initPage
+//    load one page and rescale
+//---------------------------------------------------------
+
+void Omr::initPage(OmrPage* page)
+      {
+      page->read();
+
+      //do the rescaling here
+      int new_w = page->image().width() * _spatium/page->spatium();
+      int new_h = page->image().height() * _spatium/page->spatium();
+      QImage image = page->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
+      page->setImage(image);
+      page->read();
+      }
+
+//---------------------------------------------------------
+//   processPages
+//    Run a per page action for all pages at once on the
+//    global thread pool. Pages own their image and are
+//    independent of each other until the score gets
+//    assembled, which happens later in page order.
+//    return false if canceled
+//---------------------------------------------------------
+
+bool Omr::processPages(int ID, QProgressDialog* progress)
+      {
+      QFuture<void> future = QtConcurrent::map(_pages, [this, ID](OmrPage* page) {
+            if (ID == INIT_PAGE)
+                  initPage(page);
+            else if (ID == SYSTEM_IDENTIFICATION)
+                  page->identifySystems();
+            });
+      // keep the progress dialog responsive while waiting
+      QFutureWatcher<void> watcher;
+      QEventLoop loop;
+      QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+      QObject::connect(progress, &QProgressDialog::canceled, &watcher, &QFutureWatcher<void>::cancel);
+      watcher.setFuture(future);
+      if (!watcher.isFinished())
+            loop.exec();
+      watcher.waitForFinished();
+      return !watcher.isCanceled();
+      }
+
 //---------------------------------------------------------
 //   spatiumMM
 //---------------------------------------------------------
@@ -52,6 +52,8 @@ class Omr {
       static void initUtils();
 
       void process1(int page);
+      void initPage(OmrPage* page);
+      bool processPages(int ID, QProgressDialog* progress);
 
 
       enum ActionID { READ_PDF, INIT_PAGE, FINALIZE_PARMS, SYSTEM_IDENTIFICATION, ACTION_NUM};
@@ -62,6 +64,7 @@ public:
       Omr(const QString& path, Score*);
 
       static char bitsSetTable[256];
+      static bool parallel;               // run per page actions on the global thread pool
 
       bool readPdf();
       int pagesInDocument() const;
@@ -72,69 +72,95 @@ double Pattern::match(const QImage*, int , int) const
     return 0.0;
     }
 
+//---------------------------------------------------------
+//   match
+//    log likelihood ratio of the model against the
+//    background for the image area at col, row
+//---------------------------------------------------------
+
 double Pattern::match(const QImage* img, int col, int row, double bg_parm) const
       {
-#if 0
-      double scr = 0;
-      for (int y = 0; y < rows; ++y) {
-            for (int x = 0; x < cols; x++) {
-                  if(col+x >= img->size().width() || row+y >= img->size().height()) continue;
-                  QRgb c = img->pixel(col+x, row+y);
-                  bool black = (qGray(c) < 125);
-                  scr += black ? 1 : 0;
-                  }
-            }
-      return scr;
-#endif
-      double k = 0;
-      
-      //return k;
+      if (_logWhite.empty())
+            return 0.0;
       if (bg_parm < 0.00001)
             bg_parm = 0.00001;
       if (bg_parm > 0.99999)
             bg_parm = 0.99999;
-            
+
       double log_bg_black = log(bg_parm);
       double log_bg_white = log(1.0-bg_parm);
-      
+
+      const int iw = img->width();
+      const int ih = img->height();
+      const QImage::Format format = img->format();
+      const bool mono = format == QImage::Format_MonoLSB || format == QImage::Format_Mono;
+
+      if (mono && col >= 0 && row >= 0 && col + cols <= iw && row + rows <= ih) {
+            //
+            // fast path: the pattern lies completely inside of a
+            // binary image; read the pixel bits directly and only
+            // add up the precomputed ratios of the black pixels
+            //
+            const uint black = qGray(img->color(1)) < 125 ? 1 : 0;
+            const bool lsb   = format == QImage::Format_MonoLSB;
+            double k   = _logWhiteSum;
+            int nblack = 0;
+            for (int y = 0; y < rows; ++y) {
+                  const uchar* line = img->constScanLine(row + y);
+                  const double* ratio = &_logRatio[y * cols];
+                  for (int x = 0; x < cols; ++x) {
+                        int px   = col + x;
+                        uint bit = lsb ? (line[px >> 3] >> (px & 7)) : (line[px >> 3] >> (7 - (px & 7)));
+                        if ((bit & 1) == black) {
+                              k += ratio[x];
+                              ++nblack;
+                              }
+                        }
+                  }
+            return k - nblack * log_bg_black - (rows * cols - nblack) * log_bg_white;
+            }
+
+      double k = 0;
       for (int y = 0; y < rows; ++y) {
             for (int x = 0; x < cols; x++) {
-                  if (col+x >= img->size().width() || row+y >= img->size().height())
+                  if (col+x >= iw || row+y >= ih)
                         continue;
                   QRgb c = img->pixel(col+x, row+y);
                   bool black = (qGray(c) < 125);
+                  int i = y * cols + x;
+                  if (black)
+                        k += _logRatio[i] + _logWhite[i] - log_bg_black;
+                  else
+                        k += _logWhite[i] - log_bg_white;
+                  }
+            }
+      return k;
+      }
 
+//---------------------------------------------------------
+//   initLogTables
+//    precompute the per pixel log probabilities of the
+//    model so that match() does not need to call log()
+//---------------------------------------------------------
+
+void Pattern::initLogTables()
+      {
+      _logWhite.resize(rows * cols);
+      _logRatio.resize(rows * cols);
+      _logWhiteSum = 0.0;
+      for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
                   double bs_scr = model[y][x];
                   if (bs_scr < 0.00001)
                         bs_scr = 0.00001;
                   if (bs_scr > 0.99999)
                         bs_scr = 0.99999;
-                  
-                  double log_black = log(bs_scr) - log_bg_black;
-                  double log_white = log(1.0 - bs_scr) - log_bg_white;
-                  
-                  k += black?log_black:log_white;
-                  
+                  int i = y * cols + x;
+                  _logWhite[i] = log(1.0 - bs_scr);
+                  _logRatio[i] = log(bs_scr) - _logWhite[i];
+                  _logWhiteSum += _logWhite[i];
                   }
             }
-      return k;
-#if 0
-      for (int x = 0; x < bytes; ++x) {
-            uchar a = *p1++;
-            uchar b1 = *p2;
-            uchar b2 = *(p2 + 1);
-            p2++;
-            uchar b  = (b1 >> shift) | (b2 << (7 - shift));
-            uchar v = a ^ b;
-            k += Omr::bitsSetTable[v];
-            }
-      uchar a = *p1++;
-      uchar b1 = *p2;
-      uchar b2 = *(p2 + 1) & (0xff << eshift);
-      uchar b  = (b1 >> shift) | (b2 << (7 - shift));
-      uchar v = a ^ b;
-      k += Omr::bitsSetTable[v];
-#endif
       }
 
 //---------------------------------------------------------
@@ -203,6 +229,7 @@ Pattern::Pattern(Score *s, QString name)
                   for(int j = 0; j < cols; j++)
                         in >> model[i][j];
                   }
+            initLogTables();
             }
       f.close();
       }
@@ -41,6 +41,11 @@ class Pattern {
       float **model;
       int rows;
       int cols;
+      std::vector<double> _logWhite;      // log(1-p) per model pixel, row major
+      std::vector<double> _logRatio;      // log(p) - log(1-p) per model pixel
+      double _logWhiteSum;
+
+      void initLogTables();
 
    public:
       Pattern();
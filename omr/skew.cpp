@@ -129,18 +129,27 @@ static void radonProjection(RadonInfo* src, RadonInfo* dst, int sign, ulong* pro
 void OmrPage::radonTransform(ulong* projection, int w, int n, const QRect& r)
       {
       int h = r.height();
-      RadonInfo* src = new RadonInfo(w, h);
-      RadonInfo* dst = new RadonInfo(w, h);
 
-      src->reset();
-      for (int y = 0; y < h; y++) {
-            int i = n;
-            const uchar* p = (const uchar*)scanLine(r.y() + y);
-            for (int x = 0; x < n; ++x)
-                  src->setCell(--i, y, Omr::bitsSetTable[*p++]);
-            }
-      radonProjection(src, dst, -1, projection);
+      //
+      // negative and positive angles are independent of each other
+      // and are computed concurrently, each with its own buffers
+      //
+      std::vector<ulong> negProjection(2 * w - 1);
+      QFuture<void> negative = QtConcurrent::run([this, &negProjection, w, n, h, &r]() {
+            RadonInfo src(w, h);
+            RadonInfo dst(w, h);
+            src.reset();
+            for (int y = 0; y < h; y++) {
+                  int i = n;
+                  const uchar* p = (const uchar*)scanLine(r.y() + y);
+                  for (int x = 0; x < n; ++x)
+                        src.setCell(--i, y, Omr::bitsSetTable[*p++]);
+                  }
+            radonProjection(&src, &dst, -1, negProjection.data());
+            });
 
+      RadonInfo* src = new RadonInfo(w, h);
+      RadonInfo* dst = new RadonInfo(w, h);
       src->reset();
       for (int y = 0; y < h; y++) {
             const uchar* p = (const uchar*)scanLine(r.y() + y);
@@ -148,9 +157,13 @@ void OmrPage::radonTransform(ulong* projection, int w, int n, const QRect& r)
                   src->setCell(x, y, Omr::bitsSetTable[*p++]);
             }
       radonProjection(src, dst, 1, projection);
-
       delete dst;
       delete src;
+
+      negative.waitForFinished();
+      // both halves share the zero angle entry at w - 1,
+      // the positive projection takes precedence as before
+      std::copy(negProjection.begin(), negProjection.begin() + w - 1, projection);
       }
 
 //---------------------------------------------------------
@@ -393,6 +393,8 @@ void EventMap::fixupMIDI()
       while (it != end()) {
             /* ME_NOTEOFF is never emitted, no need to check for it */
             if (it->second.type() == ME_NOTEON) {
+                  /* events may have been kept from an earlier pass */
+                  it->second.setDiscard(0);
                   unsigned short np = info[it->second.channel()].nowPlaying[it->second.pitch()];
                   if (it->second.velo() == 0) {
                         /* already off (should not happen) or still playing? */
@@ -418,4 +420,47 @@ void EventMap::fixupMIDI()
             free((void *)info);
       }
 
+//---------------------------------------------------------
+//   class EventMap::eraseRange
+//    Remove the events rendered for utick range
+//    [tick1, tick2). Note offs in this range which end
+//    notes started before tick1 are kept, note offs after
+//    tick2 which end notes started in this range are
+//    removed as well.
+//---------------------------------------------------------
+
+void EventMap::eraseRange(int tick1, int tick2)
+      {
+      std::map<int, int> sounding;  // channel * 128 + pitch -> count of removed NOTEONs without NOTEOFF
+      int nSounding = 0;
+
+      auto it = lower_bound(tick1);
+      while (it != end()) {
+            const bool inRange = it->first < tick2;
+            if (!inRange && nSounding == 0)
+                  break;
+            const NPlayEvent& e = it->second;
+            bool remove = inRange;
+            if (e.type() == ME_NOTEON) {
+                  const int key = e.channel() * 128 + e.pitch();
+                  if (e.velo() == 0) {
+                        auto s = sounding.find(key);
+                        remove = (s != sounding.end() && s->second > 0);
+                        if (remove) {
+                              --s->second;
+                              --nSounding;
+                              }
+                        }
+                  else if (inRange) {
+                        ++sounding[key];
+                        ++nSounding;
+                        }
+                  }
+            if (remove)
+                  it = erase(it);
+            else
+                  ++it;
+            }
+      }
+
 }
@@ -325,6 +325,7 @@ class EventMap : public std::multimap<int, NPlayEvent> {
       int _highestChannel = 15;
    public:
       void fixupMIDI();
+      void eraseRange(int tick1, int tick2);
       void registerChannel(int c) { if (c > _highestChannel) _highestChannel = c; }
       };
 
@@ -171,6 +171,16 @@ void MasterSynthesizer::allNotesOff(int channel)
             s->allNotesOff(channel);
       }
 
+//---------------------------------------------------------
+//   setOffline
+//---------------------------------------------------------
+
+void MasterSynthesizer::setOffline(bool val)
+      {
+      for (Synthesizer* s : _synthesizer)
+            s->setOffline(val);
+      }
+
 //---------------------------------------------------------
 //   synth
 //---------------------------------------------------------
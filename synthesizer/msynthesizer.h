@@ -98,6 +98,7 @@ class MasterSynthesizer : public QObject {
       void reset();
       void allSoundsOff(int channel);
       void allNotesOff(int channel);
+      void setOffline(bool val);
 
       void setEffect(int ab, int idx);
       Effect* effect(int ab);
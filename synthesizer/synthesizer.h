@@ -80,6 +80,9 @@ class Synthesizer {
       virtual void allSoundsOff(int /*channel*/) {}
       virtual void allNotesOff(int /*channel*/) {}
 
+      // not rendering in realtime, e.g. for audio export
+      virtual void setOffline(bool) {}
+
       virtual SynthesizerGui* gui()  { return _gui; }
       };
 
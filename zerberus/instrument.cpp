@@ -38,10 +38,15 @@ Sample::~Sample()
 
 //---------------------------------------------------------
 //   readSample
+//    If preload is not zero and the sample is longer, only
+//    its first preload frames are read and the rest is
+//    streamed from disk while playing. A loop the sample
+//    is played with must be within the preloaded frames.
 //---------------------------------------------------------
 
-Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
+Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz, long long preload, bool looped, long long loopEnd)
       {
+      AudioFile a;
       if (uz) {
             QVector<MQZipReader::FileInfo> fi = uz->fileInfoList();
 
@@ -50,6 +55,16 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
                   printf("Sample::read: cannot read sample data <%s>\n", qPrintable(s));
                   return 0;
                   }
+            if (!a.open(buf)) {
+                  printf("open <%s> failed: %s\n", qPrintable(s), a.error());
+                  return 0;
+                  }
+            }
+      else if (preload > 0) {
+            if (!a.open(s)) {
+                  printf("Sample::read: open <%s> failed\n", qPrintable(s));
+                  return 0;
+                  }
             }
       else {
             QFile f(s);
@@ -58,28 +73,42 @@ Sample* ZInstrument::readSample(const QString& s, MQZipReader* uz)
                   return 0;
                   }
             buf = f.readAll();
-            }
-
-      AudioFile a;
-      if (!a.open(buf)) {
-            printf("open <%s> failed: %s\n", qPrintable(s), a.error());
-            return 0;
+            if (!a.open(buf)) {
+                  printf("open <%s> failed: %s\n", qPrintable(s), a.error());
+                  return 0;
+                  }
             }
 
       int channel = a.channels();
       sf_count_t frames  = a.frames();
       int sr      = a.samplerate();
 
-      short* data = new short[(frames + 3) * channel];
+      // ogg data is normalized per read, it cannot be read in pieces
+      sf_count_t head = frames;
+      if (preload > 0 && !uz && !a.floatData()) {
+            if (looped && loopEnd == -1)
+                  loopEnd = int(a.loopEnd());
+            head = qMax(sf_count_t(preload), sf_count_t(looped ? loopEnd + 4 : 0));
+            if (head >= frames)
+                  head = frames;
+            }
+
+      short* data = new short[(head + 3) * channel];
       Sample* sa  = new Sample(channel, data, frames, sr);
       sa->setLoopStart(a.loopStart());
       sa->setLoopEnd(a.loopEnd());
       sa->setLoopMode(a.loopMode());
 
-      if (frames != a.readData(data + channel, frames)) {
+      if (head != a.readData(data + channel, head)) {
             qDebug("Sample read failed: %s\n", a.error());
             delete sa;
-            sa = 0;
+            return 0;
+            }
+      if (head < frames) {
+            sa->setStreamed(s, head);
+            for (int i = 0; i < channel; ++i)
+                  data[i] = data[channel + i];
+            return sa;
             }
       for (int i = 0; i < channel; ++i) {
             data[i]                        = data[channel + i];
@@ -130,6 +159,20 @@ bool ZInstrument::load(const QString& path)
       return false;
       }
 
+//---------------------------------------------------------
+//   streamed
+//    return true if some sample is streamed from disk
+//---------------------------------------------------------
+
+bool ZInstrument::streamed() const
+      {
+      for (const Zone* z : _zones) {
+            if (z->sample->streamed())
+                  return true;
+            }
+      return false;
+      }
+
 //---------------------------------------------------------
 //   loadFromDir
 //---------------------------------------------------------
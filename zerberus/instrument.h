@@ -35,6 +35,7 @@ class ZInstrument {
       QString instrumentPath;
       std::list<Zone*> _zones;
       int _setcc[128];
+      long long _preloadFrames { 0 };     // if not zero, longer samples are streamed
 
       bool loadFromFile(const QString&);
       bool loadSfz(const QString&);
@@ -53,10 +54,12 @@ class ZInstrument {
       QString path() const                  { return instrumentPath; }
       const std::list<Zone*>& zones() const { return _zones;  }
       std::list<Zone*>& zones()             { return _zones;  }
-      Sample* readSample(const QString& s, MQZipReader* uz);
+      Sample* readSample(const QString& s, MQZipReader* uz, long long preload = 0, bool looped = false, long long loopEnd = -1);
       void addZone(Zone* z)                 { _zones.push_back(z); }
       void addRegion(SfzRegion&);
       int getSetCC(int v)                   { return _setcc[v]; }
+      void setPreloadFrames(long long val)  { _preloadFrames = val; }
+      bool streamed() const;
 
       static QByteArray buf;  // used during read of Sample
       static int idx;
@@ -25,14 +25,20 @@ class Sample {
       long long _loopStart;
       long long _loopEnd;
       int _loopMode;
+      long long _headFrames;  // frames in _data, the rest is streamed from _path
+      QString _path;
 
    public:
       Sample(int ch, short* val, int f, int sr)
-         : _channel(ch), _data(val), _frames(f), _sampleRate(sr) {}
+         : _channel(ch), _data(val), _frames(f), _sampleRate(sr), _headFrames(f) {}
       ~Sample();
       bool read(const QString&);
       long long frames() const     { return _frames;          }
       short* data() const    { return _data + _channel; }
+      long long headFrames() const { return _headFrames;      }
+      bool streamed() const        { return _headFrames < _frames; }
+      const QString& path() const  { return _path;            }
+      void setStreamed(const QString& path, long long head) { _path = path; _headFrames = head; }
       int channel() const    { return _channel;         }
       int sampleRate() const { return _sampleRate;      }
 
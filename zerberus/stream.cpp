@@ -0,0 +1,193 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <algorithm>
+
+#include "audiofile/audiofile.h"
+
+#include "stream.h"
+#include "sample.h"
+
+//---------------------------------------------------------
+//   SampleStream
+//---------------------------------------------------------
+
+int SampleStream::_ringFrames = 16384;
+int SampleStream::_readChunk  = 4096;
+
+SampleStream::SampleStream()
+      {
+      }
+
+SampleStream::~SampleStream()
+      {
+      }
+
+//---------------------------------------------------------
+//   start
+//    stream the sample from the given frame on; called by
+//    the voice
+//---------------------------------------------------------
+
+void SampleStream::start(const Sample* s, long long frame)
+      {
+      _channels = s->channel();
+      _readFrame.store(frame, std::memory_order_relaxed);
+      _startFrame.store(frame, std::memory_order_relaxed);
+      _sample.store(s, std::memory_order_relaxed);
+      _request.fetch_add(1, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   stop
+//---------------------------------------------------------
+
+void SampleStream::stop()
+      {
+      _sample.store(nullptr, std::memory_order_relaxed);
+      _request.fetch_add(1, std::memory_order_release);
+      }
+
+//---------------------------------------------------------
+//   fill
+//    Read the next chunk of the sample into the ring, as
+//    far as the voice has made room for it.
+//    return true if something was done
+//---------------------------------------------------------
+
+bool SampleStream::fill()
+      {
+      int request = _request.load(std::memory_order_acquire);
+      if (request != _ack.load(std::memory_order_relaxed)) {
+            _file.reset();
+            _atEnd = false;
+            const Sample* s  = _sample.load(std::memory_order_relaxed);
+            long long start  = _startFrame.load(std::memory_order_relaxed);
+            if (s) {
+                  _file.reset(new AudioFile);
+                  if (!_file->open(s->path()) || _file->seekFrame(start) != start) {
+                        qDebug("Zerberus: cannot stream <%s>", qPrintable(s->path()));
+                        _file.reset();
+                        }
+                  _fileChannels = s->channel();
+                  if (_ring.size() < size_t(_ringFrames * _fileChannels))
+                        _ring.resize(_ringFrames * _fileChannels);
+                  }
+            _frames = _ringFrames;
+            _chunk  = _readChunk;
+            _endFrame.store(start, std::memory_order_relaxed);
+            _ack.store(request, std::memory_order_release);
+            return true;
+            }
+      if (!_file)
+            return false;
+
+      long long end   = _endFrame.load(std::memory_order_relaxed);
+      long long space = _readFrame.load(std::memory_order_acquire) + _frames - end;
+      int pos         = end % _frames;
+      long long n     = qMin(qMin(space, (long long)_chunk), (long long)(_frames - pos));
+      if (n <= 0)
+            return false;
+      sf_count_t r = _atEnd ? 0 : _file->readData(_ring.data() + pos * _fileChannels, n);
+      if (r < n) {
+            // past the end of the sample the voice reads silence
+            r = qMax(r, sf_count_t(0));
+            std::fill(_ring.begin() + (pos + r) * _fileChannels, _ring.begin() + (pos + n) * _fileChannels, 0);
+            _atEnd = true;
+            }
+      _endFrame.store(end + n, std::memory_order_release);
+      return true;
+      }
+
+//---------------------------------------------------------
+//   ~StreamReader
+//---------------------------------------------------------
+
+StreamReader::~StreamReader()
+      {
+      stopReading();
+      }
+
+//---------------------------------------------------------
+//   startReading
+//---------------------------------------------------------
+
+void StreamReader::startReading()
+      {
+      if (isRunning())
+            return;
+      _quit = false;
+      start(QThread::HighPriority);
+      }
+
+//---------------------------------------------------------
+//   stopReading
+//    stop the thread, the streams can then be filled by
+//    their voices
+//---------------------------------------------------------
+
+void StreamReader::stopReading()
+      {
+      _quit = true;
+      _wait.wakeAll();
+      wait();
+      }
+
+//---------------------------------------------------------
+//   stopStreams
+//    Stop all streams and close their files. When this
+//    returns the reader does not access any sample.
+//---------------------------------------------------------
+
+void StreamReader::stopStreams()
+      {
+      QMutexLocker locker(&_mutex);
+      for (SampleStream* s : _streams) {
+            s->stop();
+            if (!isRunning())
+                  s->fill();
+            }
+      }
+
+//---------------------------------------------------------
+//   waitIdle
+//    Wait for a pass over all streams which started after
+//    this call and found nothing to do: the streams are
+//    then filled as far as their voices made room.
+//    Used by the tests.
+//---------------------------------------------------------
+
+void StreamReader::waitIdle()
+      {
+      int n = _idlePasses.load();
+      while (isRunning() && _idlePasses.load() - n < 2) {
+            _wait.wakeAll();
+            QThread::usleep(100);
+            }
+      }
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+void StreamReader::run()
+      {
+      QMutexLocker locker(&_mutex);
+      while (!_quit) {
+            bool busy = false;
+            for (SampleStream* s : _streams)
+                  busy |= s->fill();
+            if (!busy) {
+                  ++_idlePasses;
+                  _wait.wait(&_mutex, 2);
+                  }
+            }
+      }
+
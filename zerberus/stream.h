@@ -0,0 +1,105 @@
+//=============================================================================
+//  Zerberus
+//  Zample player
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __STREAM_H__
+#define __STREAM_H__
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+
+class AudioFile;
+class Sample;
+
+//---------------------------------------------------------
+//   SampleStream
+//    Ring buffer with the frames of a streamed sample
+//    which follow its preloaded head. Every voice has one.
+//    It is filled from the file by the StreamReader
+//    thread or, when rendering offline, by the voice
+//    itself.
+//---------------------------------------------------------
+
+class SampleStream {
+      static int _ringFrames;             // ring size of the streams started from now on
+      static int _readChunk;              // frames read from the file at once
+
+      // written by the voice
+      std::atomic<const Sample*> _sample { nullptr };
+      std::atomic<long long> _startFrame { 0 };
+      std::atomic<int> _request          { 0 };
+      std::atomic<long long> _readFrame  { 0 };   // the voice reads no frame before this one
+      int _channels                      { 1 };
+
+      // written by the filling thread
+      std::atomic<int> _ack              { 0 };   // request the ring is filled for
+      std::atomic<long long> _endFrame   { 0 };   // frames before this one are in the ring
+      int _frames                        { 0 };   // ring size, taken over with the request
+      int _chunk                         { 0 };
+      std::vector<short> _ring;
+      std::unique_ptr<AudioFile> _file;
+      int _fileChannels                  { 1 };
+      bool _atEnd                        { false };
+
+   public:
+      SampleStream();
+      ~SampleStream();
+
+      static void setRingSize(int frames, int readChunk) { _ringFrames = frames; _readChunk = readChunk; }
+
+      void start(const Sample*, long long frame);
+      void stop();
+      void setReadFrame(long long frame) { _readFrame.store(frame, std::memory_order_release); }
+      bool fill();
+
+      //---------------------------------------------------
+      //   value
+      //    return false if the frame is not read yet
+      //---------------------------------------------------
+
+      bool value(long long frame, int channel, short& v) const {
+            if (_ack.load(std::memory_order_acquire) != _request.load(std::memory_order_relaxed))
+                  return false;
+            if (frame >= _endFrame.load(std::memory_order_acquire))
+                  return false;
+            v = _ring[(frame % _frames) * _channels + channel];
+            return true;
+            }
+      };
+
+//---------------------------------------------------------
+//   StreamReader
+//    background thread filling the sample streams of the
+//    voices of one Zerberus instance
+//---------------------------------------------------------
+
+class StreamReader : public QThread {
+      std::vector<SampleStream*> _streams;
+      QMutex _mutex;
+      QWaitCondition _wait;
+      std::atomic<bool> _quit { false };
+      std::atomic<int> _idlePasses { 0 };
+
+      virtual void run() override;
+
+   public:
+      StreamReader(const std::vector<SampleStream*>& streams) : _streams(streams) {}
+      ~StreamReader();
+      void startReading();
+      void stopReading();
+      void stopStreams();
+      void waitIdle();
+      };
+
+#endif
+
@@ -46,7 +46,22 @@ void Envelope::setTime(float ms, int sampleRate)
 
 Voice::Voice(Zerberus* z)
       {
-      _zerberus = z;
+      _zerberus  = z;
+      _streaming = false;
+      _underrun  = false;
+      }
+
+//---------------------------------------------------------
+//   off
+//---------------------------------------------------------
+
+void Voice::off()
+      {
+      _state = VoiceState::OFF;
+      if (_streaming) {
+            _stream.stop();
+            _streaming = false;
+            }
       }
 
 //---------------------------------------------------------
@@ -98,6 +113,14 @@ void Voice::start(Channel* c, int key, int v, const Zone* zone, double durSinceN
       Sample* s = z->sample;
       audioChan = s->channel();
       data      = s->data() + z->offset * audioChan;
+      _offset   = z->offset;
+      _streaming = s->streamed();
+      _underrun = false;
+      if (_streaming) {
+            // everything after the preloaded head comes from the stream
+            _headEnd = (s->headFrames() - z->offset) * audioChan;
+            _stream.start(s, std::max(s->headFrames(), z->offset));
+            }
       //avoid processing sample if offset is bigger than sample length
       eidx      = std::max((s->frames() - z->offset - 1) * audioChan, 0ll);
       _loopMode = z->loopMode;
@@ -288,6 +311,13 @@ void Voice::process(int frames, float* p)
                   _samplesSinceStart++;
                   }
             }
+      if (_streaming) {
+            _stream.setReadFrame(_offset + phase.index() - 1);
+            if (_underrun) {
+                  _zerberus->addUnderrun();
+                  _underrun = false;
+                  }
+            }
       }
 
 //---------------------------------------------------------
@@ -317,17 +347,46 @@ short Voice::getData(long long pos) {
             return 0;
 
       if (!_looping)
-            return data[pos];
+            return sampleData(pos);
 
       long long loopEnd = _loopEnd * audioChan;
       long long loopStart = _loopStart * audioChan;
 
       if (pos < loopStart)
-            return data[loopEnd + (pos - loopStart) + audioChan];
+            return sampleData(loopEnd + (pos - loopStart) + audioChan);
       else if (pos > (loopEnd + audioChan - 1))
-            return data[loopStart + (pos - loopEnd) - audioChan];
+            return sampleData(loopStart + (pos - loopEnd) - audioChan);
       else
+            return sampleData(pos);
+      }
+
+//---------------------------------------------------------
+//   sampleData
+//    Values after the preloaded head of a streamed sample
+//    are taken from the stream. If the reader thread did
+//    not catch up, the voice plays silence. Offline the
+//    stream is filled right here.
+//---------------------------------------------------------
+
+short Voice::sampleData(long long pos)
+      {
+      if (!_streaming || pos < _headEnd)
             return data[pos];
+
+      long long frame = _offset + pos / audioChan;
+      int channel     = pos % audioChan;
+      short v;
+      if (_stream.value(frame, channel, v))
+            return v;
+      if (_zerberus->offline()) {
+            _stream.setReadFrame(_offset + phase.index() - 1);
+            while (_stream.fill()) {
+                  if (_stream.value(frame, channel, v))
+                        return v;
+                  }
+            }
+      _underrun = true;
+      return 0;
       }
 
 //---------------------------------------------------------
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <math.h>
 #include "filter.h"
+#include "stream.h"
 
 // Disable warning C4201: nonstandard extension used: nameless struct/union in VS2017
 #if (defined (_MSCVER) || defined (_MSC_VER))
@@ -127,6 +128,11 @@ class Voice {
 
       short* data;
       long long eidx;
+      long long _offset;            // first frame of the sample played
+      long long _headEnd;           // data index of the first streamed value
+      bool _streaming;
+      bool _underrun;
+      SampleStream _stream;
       LoopMode _loopMode;
       OffMode _offMode;
       int _offBy;
@@ -158,6 +164,7 @@ class Voice {
       void process(int frames, float*);
       void updateLoop();
       short getData(long long pos);
+      short sampleData(long long pos);
 
       Channel* channel() const    { return _channel; }
       int key() const             { return _key;     }
@@ -170,11 +177,12 @@ class Voice {
       void stop()                 { envelopes[currentEnvelope].step(); envelopes[V1Envelopes::RELEASE].max = envelopes[currentEnvelope].val; currentEnvelope = V1Envelopes::RELEASE; _state = VoiceState::STOP;      }
       void stop(float time);
       void sustained()            { _state = VoiceState::SUSTAINED; }
-      void off()                  { _state = VoiceState::OFF;       }
+      void off();
       const char* state() const;
       LoopMode loopMode() const   { return _loopMode; }
       int getSamplesSinceStart()  { return _samplesSinceStart;    }
       float getGain()             { return gain; }
+      SampleStream* stream()      { return &_stream; }
 
       OffMode offMode() const     { return _offMode;  }
       int offBy() const           { return _offBy;    }
@@ -49,6 +49,7 @@ Zerberus::Zerberus()
             }
       
       freeVoices.init(this);
+      _streamReader.reset(new StreamReader(freeVoices.streams()));
       for (int i = 0; i < MAX_CHANNEL; ++i)
             _channel[i] = new Channel(this, i);
       busy = true;      // no sf loaded yet
@@ -61,6 +62,7 @@ Zerberus::Zerberus()
 Zerberus::~Zerberus()
       {
       busy = true;
+      _streamReader->stopReading();
       while (!instruments.empty()) {
             auto i  = instruments.front();
             auto it = instruments.begin();
@@ -238,6 +240,36 @@ void Zerberus::process(unsigned frames, float* p, float*, float*)
             }
       }
 
+//---------------------------------------------------------
+//   setOffline
+//    Offline the voices read their streamed samples
+//    themselves, the output does not depend on how fast
+//    the disk is.
+//---------------------------------------------------------
+
+void Zerberus::setOffline(bool val)
+      {
+      _offline = val;
+      if (_offline)
+            _streamReader->stopReading();
+      else {
+            for (ZInstrument* i : instruments) {
+                  if (i->streamed())
+                        _streamReader->startReading();
+                  }
+            }
+      }
+
+//---------------------------------------------------------
+//   stopStreams
+//    before samples are deleted
+//---------------------------------------------------------
+
+void Zerberus::stopStreams()
+      {
+      _streamReader->stopStreams();
+      }
+
 //---------------------------------------------------------
 //   name
 //---------------------------------------------------------
@@ -379,6 +411,7 @@ bool Zerberus::removeSoundFont(const QString& s)
                         if (it1 == globalInstruments.end())
                               return false;
                         globalInstruments.erase(it1);
+                        stopStreams();
                         delete i;
                         }
                   
@@ -457,6 +490,8 @@ bool Zerberus::loadInstrument(const QString& s)
                         for (int i = 0; i < MAX_CHANNEL; ++i)
                               _channel[i]->setInstrument(instr);
                         }
+                  if (instr->streamed() && !_offline)
+                        _streamReader->startReading();
                   busy = false;
                   return true;
                   }
@@ -472,6 +507,8 @@ bool Zerberus::loadInstrument(const QString& s)
             }
       busy = true;
       ZInstrument* instr = new ZInstrument(this);
+      if (Ms::preferences.getBool(PREF_IO_ZERBERUS_STREAMSAMPLES))
+            instr->setPreloadFrames(Ms::preferences.getInt(PREF_IO_ZERBERUS_PRELOADFRAMES));
 
       try {
             if (instr->load(path)) {
@@ -485,6 +522,8 @@ bool Zerberus::loadInstrument(const QString& s)
                         for (int i = 0; i < MAX_CHANNEL; ++i)
                               _channel[i]->setInstrument(instr);
                         }
+                  if (instr->streamed() && !_offline)
+                        _streamReader->startReading();
                   busy = false;
                   return true;
                   }
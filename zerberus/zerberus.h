@@ -66,6 +66,15 @@ class VoiceFifo {
             }
 
       bool empty() const { return buffer.empty(); }
+
+      std::vector<SampleStream*> streams() const {
+            std::vector<SampleStream*> sl;
+            for (const auto& v : voices) {
+                  if (v)
+                        sl.push_back(v->stream());
+                  }
+            return sl;
+            }
       };
 
 //---------------------------------------------------------
@@ -88,6 +97,9 @@ class Zerberus : public Ms::Synthesizer {
       Voice* activeVoices = 0;
       int _loadProgress = 0;
       bool _loadWasCanceled = false;
+      bool _offline = false;
+      std::unique_ptr<StreamReader> _streamReader;
+      std::atomic<int> _underruns { 0 };
 
       QMutex mutex;
 
@@ -95,6 +107,7 @@ class Zerberus : public Ms::Synthesizer {
       void trigger(Channel*, int key, int velo, Trigger, int cc, int ccVal, double durSinceNoteOn);
       void processNoteOff(Channel*, int pitch);
       void processNoteOn(Channel* cp, int key, int velo);
+      void stopStreams();
 
    public:
       Zerberus();
@@ -120,6 +133,12 @@ class Zerberus : public Ms::Synthesizer {
 
       virtual const char* name() const;
 
+      virtual void setOffline(bool) override;
+      bool offline() const          { return _offline; }
+      int underruns() const         { return _underruns; }
+      void addUnderrun()            { ++_underruns; }
+      void waitForStreams()         { _streamReader->waitIdle(); }
+
       virtual Ms::SynthesizerGroup state() const;
       virtual bool setState(const Ms::SynthesizerGroup&);
 